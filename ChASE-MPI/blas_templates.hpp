@@ -67,6 +67,25 @@ template <typename T>
 void t_lacpy(const char uplo, const std::size_t m, const std::size_t n,
              const T* a, const std::size_t lda, T* b, const std::size_t ldb);
 
+// Copies the m x n matrix a into b, as t_lacpy('A', ...). The columns are cut
+// into tiles of 64 KiB which are shared between the OpenMP threads, if the
+// matrix has at least t_copy_threshold() bytes.
+template <typename T>
+void t_lacpy_par(const std::size_t m, const std::size_t n, const T* a,
+                 const std::size_t lda, T* b, const std::size_t ldb);
+
+// The size in bytes from which the copies of the redistributions are
+// threaded. Below it, the start of a parallel region costs more than the
+// copy on a single core. It can be tuned by the environment variable
+// CHASE_COPY_THRESHOLD, 0 threads all the copies.
+inline std::size_t t_copy_threshold();
+
+// Copies the m x n matrix a into b while converting between precisions, in
+// the manner of LAPACK's ?lag2? routines.
+template <typename T, typename U>
+void t_lag2(const std::size_t m, const std::size_t n, const T* a,
+            const std::size_t lda, U* b, const std::size_t ldb);
+
 template <typename T>
 std::size_t t_geqrf(int matrix_layout, std::size_t m, std::size_t n, T* a,
                     std::size_t lda, T* tau);
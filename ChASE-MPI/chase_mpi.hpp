@@ -10,6 +10,7 @@
 #include <cstring> //memcpy
 #include <iostream>
 #include <memory>
+#include <string>
 
 #include "mpi.h"
 
@@ -18,6 +19,7 @@
 #include "algorithm/chase.hpp"
 
 #include "blas_templates.hpp"
+#include "chase_mpi_checkpoint.hpp"
 #include "chase_mpi_matrices.hpp"
 
 #include "./impl/chase_mpidla.hpp"
@@ -121,6 +123,27 @@ public:
         nprocs_ = 1;
     }
 
+    //! A constructor of the ChaseMpi class for shared-memory architectures,
+    //! which takes an already constructed implementation of
+    //! ChaseMpiDLAInterface, e.g., ChaseMpiDLAMatrixFreeSeq which does not
+    //! store `H` explicitly.
+    /*!
+       @param N: size of the square matrix defining the eigenproblem.
+       @param nev: Number of desired extremal eigenvalues.
+       @param nex: Number of eigenvalues augmenting the search space.
+       @param dla_input: the backend, ChaseMpi takes ownership of it.
+    */
+    ChaseMpi(std::size_t N, std::size_t nev, std::size_t nex,
+             ChaseMpiDLAInterface<T>* dla_input)
+        : N_(N), nev_(nev), nex_(nex), rank_(0), locked_(0),
+          config_(N, nev, nex),
+          dla_(std::unique_ptr<ChaseMpiDLAInterface<T>>(dla_input))
+    {
+        ritzv_ = dla_->get_Ritzv();
+        resid_ = dla_->get_Resids();
+        nprocs_ = 1;
+    }
+
     // case 2: MPI
     //! A constructor of the ChaseMpi class which gives an implenentation of
     //! ChASE for distributed-memory architecture, with the support of MPI.
@@ -256,16 +279,40 @@ public:
     //! \return `ritzv_`: an array stores the computed Ritz values.
     Base<T>* GetRitzv() override { return ritzv_; }
 
+    //! This member function implements the virtual one declared in Chase class.
+    //! Returns the number of converged eigenpairs of the last solve.
+    //! \return `locked_`: the number of locked eigenpairs.
+    std::size_t GetNconv() override { return locked_; }
+
     //! This member function implements the virtual one declared in Chase class.
     //! It resets `locked_` to `0` and start to solve a (new) eigenproblem.
     void Start() override
     {
         locked_ = 0;
         dla_->Start();
+
+        const std::string& file = config_.GetTelemetryFile();
+        if (file.empty() || rank_ != 0)
+        {
+            telemetry_.reset();
+        }
+        else if (!telemetry_ || telemetry_->file() != file)
+        {
+            telemetry_.reset(new ChaseTelemetry(file));
+        }
+        if (telemetry_)
+        {
+            telemetry_->start_solve();
+        }
     }
     //! This member function implements the virtual one declared in Chase class.
     //! It indicates the finalisation of solving a single eigenproblem.
-    void End() override { dla_->End(); }
+    void End() override
+    {
+        if (checkpoint_)
+            checkpoint_->wait();
+        dla_->End();
+    }
 
     bool checkSymmetryEasy() override { is_sym_ = dla_->checkSymmetryEasy(); return is_sym_; }
 
@@ -331,12 +378,43 @@ public:
 #ifdef USE_NSIGHT
         nvtxRangePushA("HEMM");
 #endif
-        dla_->apply(alpha, beta, offset, block, locked_);
+        std::size_t chunks =
+            std::max<std::size_t>(1, std::min(config_.GetFilterChunks(), block));
+        if (chunks == 1)
+        {
+            dla_->apply(alpha, beta, offset, block, locked_);
+        }
+        else
+        {
+            // pipelined: the first `block % chunks` chunks get one more column
+            std::size_t start = 0;
+            for (std::size_t i = 0; i < chunks; i++)
+            {
+                std::size_t len = block / chunks + (i < block % chunks ? 1 : 0);
+                dla_->applyChunk(alpha, beta, offset + start, len, locked_,
+                                 i == chunks - 1);
+                start += len;
+            }
+        }
 #ifdef USE_NSIGHT
         nvtxRangePop();
 #endif
     };
 
+    //! This member function implements the virtual one declared in Chase class.
+    //! The conversions of the matrix and of the non-converged vectors are done
+    //! by the derived class of `ChaseMpiDLAInterface`.
+    bool EnterSinglePrecision() override
+    {
+        return dla_->enterSinglePrecision(locked_);
+    }
+
+    //! This member function implements the virtual one declared in Chase class.
+    void LeaveSinglePrecision() override
+    {
+        dla_->leaveSinglePrecision(locked_);
+    }
+
     //! This member function performs a QR factorization with an explicit
     //! construction of the unitary matrix `Q`. After the explicit construction
     //! of Q, its first `locked_` number of vectors are overwritten by the
@@ -377,9 +455,12 @@ public:
             display_bounds = std::atoi(display_bounds_env);
         }
         
+        // the variant actually used, for the telemetry
+        std::string variant = config_.UseTSQR() ? "tsQR" : "hhQR";
+
         if (disable == 1)
         {
-            dla_->hhQR(locked_);
+            hhQR();
             isHHqr = true;
         }
         else
@@ -396,18 +477,24 @@ public:
             }
 
             int info = 1;
+            // the converged vectors are skipped by CholQR in the locked-aware
+            // mode
+            std::size_t qr_locked = config_.UseLockedQR() ? locked_ : 0;
 
             if (cond > cond_threshold_upper)
             {
-                info = dla_->shiftedcholQR2(locked_);
+                info = dla_->shiftedcholQR2(qr_locked);
+                variant = "shiftedcholQR2";
             }
             else if(cond < cond_threshold_lower)
             {
-                info = dla_->cholQR1(locked_);
+                info = dla_->cholQR1(qr_locked);
+                variant = "cholQR1";
             }
             else
             {
-                info = dla_->cholQR2(locked_);                         
+                info = dla_->cholQR2(qr_locked);                         
+                variant = "cholQR2";
             }
 
             if (info != 0)
@@ -418,11 +505,18 @@ public:
                     std::cout << "CholeskyQR doesn't work, Househoulder QR will be used." << std::endl;
                 }
 #endif
-                dla_->hhQR(locked_);
+                hhQR();
                 isHHqr = true;
+                variant += config_.UseTSQR() ? "+tsQR" : "+hhQR";
             }
         }
 
+        if (telemetry_)
+        {
+            telemetry_->add("qr", variant);
+            telemetry_->add("cond", static_cast<double>(cond));
+        }
+
         dla_->lockVectorCopyAndOrthoConcatswap(locked_, isHHqr);
     }
 
@@ -437,7 +531,15 @@ public:
     */
     void RR(Base<T>* ritzv, std::size_t block) override
     {
-        dla_->RR(block, locked_, ritzv);
+        if (config_.DoFusedRR())
+        {
+            dla_->RRResd(block, locked_, ritzv, resid_ + locked_);
+            is_resd_fused_ = true;
+        }
+        else
+        {
+            dla_->RR(block, locked_, ritzv);
+        }
     };
 
     //! This member function implements the virtual one declared in Chase class.
@@ -452,6 +554,12 @@ public:
     */
     void Resd(Base<T>* ritzv, Base<T>* resid, std::size_t fixednev) override
     {
+        // the residuals have already been computed by the fused RR
+        if (is_resd_fused_)
+        {
+            is_resd_fused_ = false;
+            return;
+        }
         std::size_t unconverged = (nev_ + nex_) - fixednev;
         dla_->Resd(ritzv, resid, locked_, unconverged);
     };
@@ -472,6 +580,21 @@ public:
 #endif
     };
 
+    //! This member function implements the virtual one declared in Chase class.
+    //! It reorders the columns of the matrices of vectors used in the
+    //! Chebyschev filter.
+    //! @param perm: the column `k` receives the former column `perm[k]`
+    void Permute(const std::vector<std::size_t>& perm) override
+    {
+#ifdef USE_NSIGHT
+        nvtxRangePushA("Permute");
+#endif
+        dla_->Permute(perm);
+#ifdef USE_NSIGHT
+        nvtxRangePop();
+#endif
+    };
+
     //! This member function implements the virtual one declared in Chase class.
     //! It estimates the upper bound of user-interested spectrum by Lanczos
     //! eigensolver
@@ -575,6 +698,45 @@ public:
     //! residual of each computed eigenpair.
     Base<T>* GetResid() override { return resid_; }
 
+    //! This member function implements the virtual one declared in Chase class.
+    //! \return the workspace held by the ChaseMpiMatrices of `dla_`.
+    Workspace& GetWorkspace() override
+    {
+        return dla_->getChaseMatrices()->workspace();
+    }
+
+    //! This member function implements the virtual one declared in Chase class.
+    //! \return the telemetry opened by Start() on the rank 0.
+    ChaseTelemetry* GetTelemetry() override { return telemetry_.get(); }
+
+    //! This member function implements the virtual one declared in Chase class.
+    //! It starts writing `state` and the current vectors `C` to the file
+    //! given by ChaseConfig::GetCheckpointFile(), see ChaseMpiCheckpoint.
+    void Checkpoint(const ChaseState<T>& state) override
+    {
+        Matrix<T> C = dla_->getChaseMatrices()->C();
+        C.sync2Ptr();
+        checkpointer()->write(config_.GetCheckpointFile(), state, C.host());
+    }
+
+    //! This member function implements the virtual one declared in Chase class.
+    //! It reads `state` and the vectors `C` from the file given by
+    //! ChaseConfig::GetCheckpointFile(), and restores the backup of `C`.
+    //! \return `false` if there is no checkpoint of this eigenproblem.
+    bool Resume(ChaseState<T>& state) override
+    {
+        Matrix<T> C = dla_->getChaseMatrices()->C();
+        if (!checkpointer()->read(config_.GetCheckpointFile(), state,
+                                  C.host()))
+        {
+            return false;
+        }
+        C.syncFromPtr();
+        dla_->initVecs();
+        locked_ = state.locked;
+        return true;
+    }
+
     //! This member function return the number of MPI processes used by ChASE
     //! \return the number of MPI ranks in the communicator used by ChASE
     int get_nprocs() override 
@@ -584,6 +746,34 @@ public:
     }
 
 private:
+    //! Householder QR of the vectors, by TSQR if ChaseConfig::UseTSQR().
+    void hhQR()
+    {
+        if (config_.UseTSQR())
+        {
+            dla_->tsQR(locked_);
+        }
+        else
+        {
+            dla_->hhQR(locked_);
+        }
+    }
+
+    //! Returns `checkpoint_`, which is created on the first checkpoint or
+    //! resume.
+    ChaseMpiCheckpoint<T>* checkpointer()
+    {
+        if (!checkpoint_)
+        {
+            if (properties_)
+                checkpoint_.reset(
+                    new ChaseMpiCheckpoint<T>(properties_.get()));
+            else
+                checkpoint_.reset(new ChaseMpiCheckpoint<T>(N_, nev_, nex_));
+        }
+        return checkpoint_.get();
+    }
+
     //! Global size of the matrix A defining the eigenproblem.
     /*!
       - For the constructor of class ChaseMpi without MPI,
@@ -692,6 +882,13 @@ private:
     */
     std::unique_ptr<ChaseMpiDLAInterface<T>> dla_;
 
+    //! The writer and reader of the checkpoints, see Checkpoint() and
+    //! Resume().
+    std::unique_ptr<ChaseMpiCheckpoint<T>> checkpoint_;
+
+    //! The per-iteration records, see GetTelemetry().
+    std::unique_ptr<ChaseTelemetry> telemetry_;
+
     //! An object of ChaseConfig class which setup all the parameters of ChASE,
     //! these parameters are either provided by users, or using the default
     //! values. This variable is initialized by the constructor of ChaseConfig
@@ -700,6 +897,10 @@ private:
     ChaseConfig<T> config_;
 
     bool is_sym_;
+
+    //! A flag indicating if the residuals of the current iteration have
+    //! already been computed by RR() through ChaseMpiDLAInterface::RRResd()
+    bool is_resd_fused_ = false;
 };
 
 } // namespace mpi
@@ -0,0 +1,338 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+#include "ChASE-MPI/chase_mpi_properties.hpp"
+#include "ChASE-MPI/impl/chase_mpidla.hpp"
+
+namespace chase
+{
+namespace mpi
+{
+
+//! Times `kernel` on all the ranks of `comm`: one untimed warm-up run, then
+//! the minimum over `repeats` runs of the maximum over the ranks of the
+//! wall-clock time of a run. The optional `before` and `after` are run,
+//! untimed, around each run of `kernel`. It is collective over `comm`.
+inline double time_kernel(MPI_Comm comm, int repeats,
+                          const std::function<void()>& kernel,
+                          const std::function<void()>& before = nullptr,
+                          const std::function<void()>& after = nullptr)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r <= repeats; r++)
+    {
+        if (before)
+        {
+            before();
+        }
+        MPI_Barrier(comm);
+        double start = MPI_Wtime();
+        kernel();
+        double t = MPI_Wtime() - start;
+        if (after)
+        {
+            after();
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &t, 1, MPI_DOUBLE, MPI_MAX, comm);
+        if (r > 0)
+        {
+            best = std::min(best, t);
+        }
+    }
+    return best;
+}
+
+//! A diagonal Hermitian matrix of eigenvalues in `[1, 2)`, which keeps the
+//! vectors well conditioned and bounded over repeated kernels, in the
+//! distribution of `props`.
+template <typename T>
+void generate_bench_hamiltonian(ChaseMpiProperties<T>* props, T* H)
+{
+    std::size_t N = props->get_N();
+    props->generateHamiltonian(
+        [N](std::size_t i, std::size_t j) {
+            return i == j ? T(1 + Base<T>(i) / N) : T(0);
+        },
+        H);
+}
+
+//! A distribution of `H` over a 2D grid of MPI ranks, as evaluated by
+//! ChaseMpiAutotuner.
+struct ChaseMpiGrid
+{
+    int dim0;       //!< number of rows of the grid
+    int dim1;       //!< number of columns of the grid
+    std::size_t mb; //!< row block size, 0 for the Block-Block distribution
+    std::size_t nb; //!< column block size, 0 for the Block-Block distribution
+
+    //! Fitted time of apply() for `b` vectors: `apply[0] + apply[1] * b`
+    double apply[2] = {0, 0};
+    //! Fitted time of asynCxHGatherC() for `b` vectors
+    double gather[2] = {0, 0};
+    //! Time of cholQR2() of the `nev+nex` vectors
+    double qr = 0;
+    //! Time of RR() of the `nev+nex` vectors, without its asynCxHGatherC()
+    double rr = 0;
+    //! Time of Resd() of the `nev+nex` vectors, without its asynCxHGatherC()
+    double resd = 0;
+    //! Predicted time of a subspace iteration, see ChaseMpiAutotuner::tune()
+    double predicted = std::numeric_limits<double>::max();
+};
+
+//! @brief Chooses the grid shape and the block sizes of ChaseMpiProperties
+//! from timings of the main kernels of a subspace iteration.
+/*!
+  For each candidate ChaseMpiGrid, tune() builds a ChaseMpiProperties and a
+  ChaseMpiDLA over the backend `MF` on a synthetic `H`, and times:
+  - apply() (one `H*C` and one `H^H*B`) and asynCxHGatherC() for two
+  numbers of vectors, to fit a latency plus a cost per vector,
+  - cholQR2(), RR() and Resd() of all the `nev+nex` vectors, the last two
+  without the asynCxHGatherC() they start with.
+  A timing is the one of time_kernel().
+  The cost model of an iteration is the one of Algorithm<T>::solve(): `deg`
+  filter steps, one QR, and one RR and one residual computation, each with
+  an asynCxHGatherC() of the active vectors. The number of active vectors
+  goes from `nev+nex` down to `nex` during a solve and is taken at its mean.
+  The candidates are the factorizations of the number of ranks into two
+  dimensions of aspect ratio at most `max_aspect`, with the Block-Block
+  distribution, unless disabled by set_block_block(), and the Block-Cyclic
+  distribution with the block sizes of set_block_sizes().
+
+  The tuning costs a few seconds of the machine it runs on and allocates the
+  matrix for every candidate, so it is meant to run once before a sequence
+  of solves.
+*/
+template <template <typename> class MF, class T>
+class ChaseMpiAutotuner
+{
+public:
+    //! @param N the size of the matrix
+    //! @param nev the number of sought eigenpairs
+    //! @param nex the extra size of the search space
+    //! @param comm the communicator of the solver
+    ChaseMpiAutotuner(std::size_t N, std::size_t nev, std::size_t nex,
+                      MPI_Comm comm)
+        : N_(N), nev_(nev), nex_(nex), comm_(comm)
+    {
+    }
+
+    //! The block sizes of the Block-Cyclic candidates, none by default.
+    void set_block_sizes(const std::vector<std::size_t>& sizes)
+    {
+        block_sizes_ = sizes;
+    }
+    //! If the Block-Block distribution is a candidate, true by default.
+    void set_block_block(bool flag) { block_block_ = flag; }
+    //! The filter degree of the cost model, 20 by default.
+    void set_deg(std::size_t deg) { deg_ = deg; }
+    //! The number of timed repeats of each kernel, 3 by default.
+    void set_repeats(int repeats) { repeats_ = std::max(1, repeats); }
+    //! The maximal ratio between the dimensions of a candidate grid, 4 by
+    //! default.
+    void set_max_aspect(int max_aspect) { max_aspect_ = max_aspect; }
+
+    //! Times all the candidates and returns the one of the smallest
+    //! predicted time of an iteration. It is collective over the
+    //! communicator.
+    ChaseMpiGrid tune()
+    {
+        candidates_.clear();
+        int nprocs;
+        MPI_Comm_size(comm_, &nprocs);
+
+        std::vector<std::size_t> sizes(block_sizes_);
+        if (block_block_ || sizes.empty())
+        {
+            sizes.insert(sizes.begin(), 0);
+        }
+        for (int d0 = 1; d0 <= nprocs; d0++)
+        {
+            int d1 = nprocs / d0;
+            if (d0 * d1 != nprocs || static_cast<std::size_t>(d0) > N_ ||
+                static_cast<std::size_t>(d1) > N_ ||
+                std::max(d0, d1) > max_aspect_ * std::min(d0, d1))
+            {
+                continue;
+            }
+            for (auto b : sizes)
+            {
+                // every rank must own at least one block
+                if (b * std::max(d0, d1) > N_)
+                {
+                    continue;
+                }
+                ChaseMpiGrid grid;
+                grid.dim0 = d0;
+                grid.dim1 = d1;
+                grid.mb = grid.nb = b;
+                candidates_.push_back(grid);
+            }
+        }
+        if (candidates_.empty())
+        {
+            // the shape MPI_Dims_create() would choose
+            int dims[2] = {0, 0};
+            MPI_Dims_create(nprocs, 2, dims);
+            ChaseMpiGrid grid;
+            grid.dim0 = dims[0];
+            grid.dim1 = dims[1];
+            grid.mb = grid.nb = 0;
+            candidates_.push_back(grid);
+        }
+
+        for (auto& grid : candidates_)
+        {
+            measure(grid);
+        }
+
+        return *std::min_element(
+            candidates_.begin(), candidates_.end(),
+            [](const ChaseMpiGrid& a, const ChaseMpiGrid& b) {
+                return a.predicted < b.predicted;
+            });
+    }
+
+    //! Returns the candidates timed by the last tune().
+    const std::vector<ChaseMpiGrid>& get_candidates() const
+    {
+        return candidates_;
+    }
+
+    //! Returns a new ChaseMpiProperties distributing `H` as `grid`, which is
+    //! owned by the caller, or by ChaseMpi when passed to its constructor.
+    ChaseMpiProperties<T>* create(const ChaseMpiGrid& grid)
+    {
+        if (grid.mb == 0)
+        {
+            return new ChaseMpiProperties<T>(
+                N_, nev_, nex_, N_ / grid.dim0, N_ / grid.dim1, grid.dim0,
+                grid.dim1, const_cast<char*>("C"), comm_);
+        }
+        return new ChaseMpiProperties<T>(
+            N_, grid.mb, grid.nb, nev_, nex_, grid.dim0, grid.dim1,
+            const_cast<char*>("C"), 0, 0, comm_);
+    }
+
+    //! Prints the timings and the predicted iteration time of every
+    //! candidate on the rank 0 of the communicator.
+    void print(std::ostream& os = std::cout) const
+    {
+        int rank;
+        MPI_Comm_rank(comm_, &rank);
+        if (rank != 0)
+        {
+            return;
+        }
+        os << "| grid    | block | apply(b)            | gather(b)           "
+              "| cholQR2  | RR       | Resd     | iteration |\n";
+        os << std::scientific << std::setprecision(2);
+        for (auto& grid : candidates_)
+        {
+            os << "| " << std::setw(3) << grid.dim0 << "x" << std::left
+               << std::setw(3) << grid.dim1 << std::right << " | "
+               << std::setw(5) << grid.mb << " | " << grid.apply[0] << "+"
+               << grid.apply[1] << "*b | " << grid.gather[0] << "+"
+               << grid.gather[1] << "*b | " << grid.qr << " | " << grid.rr
+               << " | " << grid.resd << " | " << grid.predicted << "  |\n";
+        }
+        os << std::defaultfloat;
+    }
+
+private:
+    //! See time_kernel().
+    double time(const std::function<void()>& kernel)
+    {
+        return time_kernel(comm_, repeats_, kernel);
+    }
+
+    //! Line through the timings `t1` of `b1` vectors and `t2` of `b2`
+    //! vectors, clamped to non-negative coefficients.
+    static void fit(std::size_t b1, double t1, std::size_t b2, double t2,
+                    double* line)
+    {
+        line[1] = b2 > b1 ? std::max(0.0, (t2 - t1) / (b2 - b1)) : 0;
+        line[0] = std::max(0.0, t2 - line[1] * b2);
+    }
+
+    void measure(ChaseMpiGrid& grid)
+    {
+        std::unique_ptr<ChaseMpiProperties<T>> props(create(grid));
+        std::size_t m = props->get_m();
+        std::size_t n = props->get_n();
+        std::size_t ldh = props->get_ldh();
+        std::size_t nevex = nev_ + nex_;
+
+        std::vector<T> H(ldh * n);
+        generate_bench_hamiltonian(props.get(), H.data());
+        std::vector<T> V(m * nevex);
+        std::vector<Base<T>> ritzv(nevex), resid(nevex);
+
+        ChaseMpiDLA<T> dla(props.get(), new MF<T>(props.get(), H.data(), ldh,
+                                                  V.data(), ritzv.data()));
+        dla.Start();
+        dla.initRndVecs();
+        dla.initVecs();
+
+        std::size_t b1 = std::max<std::size_t>(1, nevex / 4);
+        double g1 = time([&]() { dla.asynCxHGatherC(nevex - b1, b1, true); });
+        double g2 = time([&]() { dla.asynCxHGatherC(0, nevex, true); });
+        fit(b1, g1, nevex, g2, grid.gather);
+
+        // RR() and Resd() start with an asynCxHGatherC(), which the model
+        // counts on the active vectors
+        grid.qr = time([&]() { dla.cholQR2(0); });
+        grid.rr = std::max(
+            0.0, time([&]() { dla.RR(nevex, 0, dla.get_Ritzv()); }) - g2);
+        grid.resd = std::max(0.0, time([&]() {
+                                      dla.Resd(dla.get_Ritzv(), resid.data(),
+                                               0, nevex);
+                                  }) - g2);
+
+        // the product with H and the one with H^H, as in the filter
+        dla.initVecs();
+        double a1 = time([&]() {
+            dla.apply(T(1), T(0), 0, b1, nevex - b1);
+            dla.apply(T(1), T(0), 0, b1, nevex - b1);
+        });
+        double a2 = time([&]() {
+            dla.apply(T(1), T(0), 0, nevex, 0);
+            dla.apply(T(1), T(0), 0, nevex, 0);
+        });
+        fit(b1, a1 / 2, nevex, a2 / 2, grid.apply);
+        dla.End();
+
+        double active = (nevex + nex_) / 2.0;
+        grid.predicted = deg_ * (grid.apply[0] + grid.apply[1] * active) +
+                         2 * (grid.gather[0] + grid.gather[1] * active) +
+                         grid.qr + grid.rr + grid.resd;
+    }
+
+    std::size_t N_;
+    std::size_t nev_;
+    std::size_t nex_;
+    MPI_Comm comm_;
+    std::vector<std::size_t> block_sizes_;
+    bool block_block_ = true;
+    std::size_t deg_ = 20;
+    int repeats_ = 3;
+    int max_aspect_ = 4;
+    std::vector<ChaseMpiGrid> candidates_;
+};
+
+} // namespace mpi
+} // namespace chase
@@ -0,0 +1,380 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mpi.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algorithm/interface.hpp"
+#include "ChASE-MPI/chase_mpi_properties.hpp"
+
+namespace chase
+{
+namespace mpi
+{
+
+//! @brief Writes and reads the checkpoints of ChaseMpi.
+/*!
+  A checkpoint file starts with a header holding the dimensions of the
+  eigenproblem, the interval mode and a ChaseState, followed by the `N * (nev+nex)` vectors in
+  column-major order.
+  - With MPI, the vectors are written and read with collective MPI-IO, each
+  MPI rank accessing the rows it owns in the distribution of `H` (see
+  ChaseMpiProperties::create_vectors_filetype()). Only the first column of
+  the grid writes, as the other columns hold copies of the same rows.
+  - Without MPI, the file is accessed with C++ streams.
+
+  A checkpoint is first written to `file.tmp`, which is renamed to `file`
+  once it is complete. The vectors are copied into a buffer of this class,
+  such that the solve goes on while they are written:
+  - by a background thread, without MPI or if MPI provides
+  `MPI_THREAD_MULTIPLE`,
+  - by a nonblocking collective write otherwise.
+  The write is completed by wait(), which is called at the latest by the
+  next write() or read().
+*/
+template <class T>
+class ChaseMpiCheckpoint
+{
+public:
+    //! A constructor for the **Non-MPI case**, in which all the `N` rows of
+    //! the vectors are local.
+    ChaseMpiCheckpoint(std::size_t N, std::size_t nev, std::size_t nex)
+        : N_(N), nev_(nev), nex_(nex), rows_(N), properties_(nullptr)
+    {
+    }
+
+    //! A constructor for the **MPI case**, the local rows are given by
+    //! `properties`.
+    ChaseMpiCheckpoint(ChaseMpiProperties<T>* properties)
+        : N_(properties->get_N()), nev_(properties->GetNev()),
+          nex_(properties->GetNex()), rows_(properties->get_m()),
+          properties_(properties)
+    {
+    }
+
+    ChaseMpiCheckpoint(const ChaseMpiCheckpoint&) = delete;
+
+    ~ChaseMpiCheckpoint()
+    {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (properties_ != nullptr && finalized)
+        {
+            // nothing can be completed or freed anymore
+            if (thread_.joinable())
+            {
+                thread_.detach();
+            }
+            return;
+        }
+
+        wait();
+        if (comm_ != MPI_COMM_NULL)
+        {
+            MPI_Type_free(&filetype_);
+            MPI_Comm_free(&comm_);
+        }
+    }
+
+    //! Starts writing `state` and the local rows `V` (of size
+    //! `rows * (nev+nex)`) of the vectors to `filename`.
+    void write(const std::string& filename, const ChaseState<T>& state,
+               const T* V)
+    {
+        wait();
+
+        std::size_t nevex = nev_ + nex_;
+        header_ = serialize(state);
+        target_ = filename;
+        tmp_ = filename + ".tmp";
+
+        if (properties_ == nullptr)
+        {
+            vecs_.assign(V, V + rows_ * nevex);
+            thread_ = std::thread([this]() {
+                std::ofstream output(tmp_, std::ios::binary);
+                output.write(header_.data(), header_.size());
+                output.write(reinterpret_cast<const char*>(vecs_.data()),
+                             vecs_.size() * sizeof(T));
+                output.close();
+                if (output)
+                {
+                    std::rename(tmp_.c_str(), target_.c_str());
+                }
+            });
+            return;
+        }
+
+        setup();
+
+        if (MPI_File_open(comm_, tmp_.data(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          MPI_INFO_NULL, &file_) != MPI_SUCCESS)
+        {
+            if (rank_ == 0)
+            {
+                std::cout << "Can't open checkpoint file - " << tmp_
+                          << std::endl;
+            }
+            return;
+        }
+        MPI_File_set_size(file_, 0);
+
+        if (rank_ == 0)
+        {
+            MPI_File_write_at(file_, 0, header_.data(), header_.size(),
+                              MPI_BYTE, MPI_STATUS_IGNORE);
+        }
+
+        int count = 0;
+        if (writer_)
+        {
+            vecs_.assign(V, V + rows_ * nevex);
+            count = static_cast<int>(vecs_.size());
+        }
+        MPI_File_set_view(file_, header_.size(), getMPI_Type<T>(), filetype_,
+                          "native", MPI_INFO_NULL);
+
+        if (threaded_)
+        {
+            thread_ = std::thread([this, count]() {
+                MPI_File_write_all(file_, vecs_.data(), count, getMPI_Type<T>(),
+                                   MPI_STATUS_IGNORE);
+                finish();
+            });
+        }
+        else
+        {
+            MPI_File_iwrite_all(file_, vecs_.data(), count, getMPI_Type<T>(),
+                                &request_);
+        }
+    }
+
+    //! Completes the pending write, if any.
+    void wait()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+        else if (request_ != MPI_REQUEST_NULL)
+        {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+            finish();
+        }
+    }
+
+    //! Reads `state` and the local rows `V` (of size `rows * (nev+nex)`) of
+    //! the vectors from `filename`.
+    //! \return `false`, without modifying `state` and `V`, if the file does
+    //! not exist or does not belong to an eigenproblem of the same size, or
+    //! if it was written in another interval mode or for another interval
+    //! center than the ones of `state`.
+    bool read(const std::string& filename, ChaseState<T>& state, T* V)
+    {
+        wait();
+
+        std::size_t nevex = nev_ + nex_;
+        std::vector<char> header(header_size());
+
+        if (properties_ == nullptr)
+        {
+            std::ifstream input(filename, std::ios::binary);
+            if (!input.is_open() || !input.read(header.data(), header.size()) ||
+                !deserialize(header, state))
+            {
+                return false;
+            }
+            input.read(reinterpret_cast<char*>(V), rows_ * nevex * sizeof(T));
+            return true;
+        }
+
+        setup();
+
+        MPI_File file;
+        if (MPI_File_open(comm_, filename.data(), MPI_MODE_RDONLY,
+                          MPI_INFO_NULL, &file) != MPI_SUCCESS)
+        {
+            return false;
+        }
+
+        MPI_File_read_at_all(file, 0, header.data(), header.size(), MPI_BYTE,
+                             MPI_STATUS_IGNORE);
+        if (!deserialize(header, state))
+        {
+            MPI_File_close(&file);
+            return false;
+        }
+
+        MPI_File_set_view(file, header.size(), getMPI_Type<T>(), filetype_,
+                          "native", MPI_INFO_NULL);
+        MPI_File_read_all(file, V, static_cast<int>(rows_ * nevex),
+                          getMPI_Type<T>(), MPI_STATUS_IGNORE);
+        MPI_File_close(&file);
+        return true;
+    }
+
+private:
+    //! The fixed-size part of the header.
+    struct Header
+    {
+        char magic[8];
+        std::uint64_t N, nev, nex, scalar;
+        std::uint64_t iteration, locked;
+        double lowerb, upperb, lambda;
+        std::uint64_t interval;
+        double center;
+    };
+
+    static constexpr char magic_[8] = "CHASECK";
+
+    //! The communicator, the file view and the threading level are set up
+    //! on the first access to a file.
+    void setup()
+    {
+        if (comm_ != MPI_COMM_NULL)
+        {
+            return;
+        }
+        // a duplicate, such that the collectives of a background write never
+        // match those of the solve
+        MPI_Comm_dup(properties_->get_comm(), &comm_);
+        MPI_Comm_rank(comm_, &rank_);
+        writer_ = properties_->get_coord()[1] == 0;
+        filetype_ = properties_->create_vectors_filetype();
+
+        int provided;
+        MPI_Query_thread(&provided);
+        threaded_ = provided == MPI_THREAD_MULTIPLE;
+    }
+
+    //! Closes the written file and moves it over the previous checkpoint.
+    void finish()
+    {
+        MPI_File_close(&file_);
+        MPI_Barrier(comm_);
+        if (rank_ == 0)
+        {
+            std::rename(tmp_.c_str(), target_.c_str());
+        }
+    }
+
+    std::size_t header_size() const
+    {
+        std::size_t nevex = nev_ + nex_;
+        return sizeof(Header) + 3 * nevex * sizeof(Base<T>) +
+               nevex * sizeof(std::uint64_t);
+    }
+
+    std::vector<char> serialize(const ChaseState<T>& state) const
+    {
+        std::size_t nevex = nev_ + nex_;
+        std::vector<char> buf(header_size());
+
+        Header h;
+        std::memcpy(h.magic, magic_, sizeof(h.magic));
+        h.N = N_;
+        h.nev = nev_;
+        h.nex = nex_;
+        h.scalar = sizeof(T);
+        h.iteration = state.iteration;
+        h.locked = state.locked;
+        h.lowerb = state.lowerb;
+        h.upperb = state.upperb;
+        h.lambda = state.lambda;
+        h.interval = state.interval;
+        h.center = state.center;
+
+        char* p = buf.data();
+        std::memcpy(p, &h, sizeof(Header));
+        p += sizeof(Header);
+        for (auto* v : {&state.ritzv, &state.resid, &state.residLast})
+        {
+            std::memcpy(p, v->data(), nevex * sizeof(Base<T>));
+            p += nevex * sizeof(Base<T>);
+        }
+        for (std::size_t i = 0; i < nevex; i++)
+        {
+            std::uint64_t d = state.degrees[i];
+            std::memcpy(p, &d, sizeof(d));
+            p += sizeof(d);
+        }
+        return buf;
+    }
+
+    bool deserialize(const std::vector<char>& buf, ChaseState<T>& state) const
+    {
+        std::size_t nevex = nev_ + nex_;
+
+        Header h;
+        std::memcpy(&h, buf.data(), sizeof(Header));
+        if (std::memcmp(h.magic, magic_, sizeof(h.magic)) != 0 ||
+            h.N != N_ || h.nev != nev_ || h.nex != nex_ ||
+            h.scalar != sizeof(T) || h.interval != state.interval ||
+            (state.interval && h.center != double(state.center)))
+        {
+            return false;
+        }
+
+        state.iteration = h.iteration;
+        state.locked = h.locked;
+        state.lowerb = h.lowerb;
+        state.upperb = h.upperb;
+        state.lambda = h.lambda;
+
+        const char* p = buf.data() + sizeof(Header);
+        for (auto* v : {&state.ritzv, &state.resid, &state.residLast})
+        {
+            v->resize(nevex);
+            std::memcpy(v->data(), p, nevex * sizeof(Base<T>));
+            p += nevex * sizeof(Base<T>);
+        }
+        state.degrees.resize(nevex);
+        for (std::size_t i = 0; i < nevex; i++)
+        {
+            std::uint64_t d;
+            std::memcpy(&d, p, sizeof(d));
+            state.degrees[i] = d;
+            p += sizeof(d);
+        }
+        return true;
+    }
+
+    std::size_t N_;    //!< global dimension of the eigenproblem
+    std::size_t nev_;  //!< number of required eigenpairs
+    std::size_t nex_;  //!< number of extra searching space
+    std::size_t rows_; //!< number of local rows of the vectors
+    ChaseMpiProperties<T>* properties_; //!< `nullptr` without MPI
+
+    MPI_Comm comm_ = MPI_COMM_NULL;      //!< a duplicate of the ChASE comm
+    MPI_Datatype filetype_;              //!< view of the local rows
+    int rank_ = 0;                       //!< rank within `comm_`
+    bool writer_ = false;                //!< if the local rows are written
+    bool threaded_ = false;              //!< if MPI-IO runs in `thread_`
+    MPI_File file_;                      //!< the file being written
+    MPI_Request request_ = MPI_REQUEST_NULL; //!< the nonblocking write
+    std::thread thread_;                 //!< the background write
+
+    std::vector<char> header_; //!< the header being written
+    std::vector<T> vecs_;      //!< the vectors being written
+    std::string target_;       //!< the name of the checkpoint
+    std::string tmp_;          //!< the name of the file being written
+};
+
+template <class T>
+constexpr char ChaseMpiCheckpoint<T>::magic_[8];
+
+} // namespace mpi
+} // namespace chase
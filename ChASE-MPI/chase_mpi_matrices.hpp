@@ -8,6 +8,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdio>
 #include <memory>
@@ -18,6 +19,7 @@
 #include <cuda_runtime.h>
 #endif
 #include "algorithm/types.hpp"
+#include "algorithm/workspace.hpp"
 
 namespace chase
 {
@@ -475,7 +477,7 @@ public:
     ChaseMpiMatrices(int mode, std::size_t N, std::size_t max_block, T* H,
                      std::size_t ldh, T* V1, Base<T>* ritzv, T* V2 = nullptr,
                      Base<T>* resid = nullptr)
-        : mode_(mode), ldh_(ldh)
+        : mode_(mode), ldh_(ldh), rows_(N), cols_(N), max_block_(max_block)
     {
         int isGPU = 0;
         if (mode == 1)
@@ -503,6 +505,8 @@ public:
         Ritzv___ = std::make_unique<Matrix<Base<T>>>(isGPU, 1, max_block, ritzv,
                                                      max_block);
         Resid___ = std::make_unique<Matrix<Base<T>>>(isGPU, 1, max_block);
+
+        reserve_workspace();
     }
 
     //! A constructor of ChaseMpiMatrices for **MPI case** which allocates
@@ -538,7 +542,7 @@ public:
     ChaseMpiMatrices(int mode, MPI_Comm comm, std::size_t N, std::size_t m,
                      std::size_t n, std::size_t max_block, T* H,
                      std::size_t ldh, T* V1, Base<T>* ritzv)
-        : mode_(mode), ldh_(ldh)
+        : mode_(mode), ldh_(ldh), rows_(m), cols_(n), max_block_(max_block)
     {
         int isGPU;
         int isCUDA_Aware;
@@ -576,6 +580,8 @@ public:
                                                      max_block);
         Resid___ = std::make_unique<Matrix<Base<T>>>(isGPU, 1, max_block);
         vv___ = std::make_unique<Matrix<T>>(isGPU, m, 1);
+
+        reserve_workspace();
     }
 
     int get_Mode() { return mode_; }
@@ -594,6 +600,47 @@ public:
     Matrix<Base<T>> Resid() { return *Resid___.get(); }
     Matrix<Base<T>> Ritzv() { return *Ritzv___.get(); }
     Matrix<T> vv() { return *vv___.get(); }
+
+    //! Allocates, on the first call only, the single-precision buffers used
+    //! by the mixed-precision filter: `Hs` of the same shape as the local
+    //! part of `H`, and `Cs`/`Bs` of the same shapes as `C`/`B`. They always
+    //! live on the CPU.
+    void allocate_single()
+    {
+        if (Hs___)
+        {
+            return;
+        }
+        Hs___ = std::make_unique<Matrix<Single<T>>>(0, rows_, cols_);
+        Cs___ = std::make_unique<Matrix<Single<T>>>(0, rows_, max_block_);
+        Bs___ = std::make_unique<Matrix<Single<T>>>(0, cols_, max_block_);
+    }
+
+    //! Returns the pool of CPU buffers used for the temporaries of the
+    //! solver.
+    Workspace& workspace() { return workspace_; }
+
+    //! Returns the scratch matrix of `slot`, with `rows` rows and at least
+    //! `cols` columns, allocated in `mode` (see Matrix). It is allocated on
+    //! the first call, and reallocated only if a different `mode` or number
+    //! of rows, or more columns are requested. Its content is unspecified.
+    Matrix<T>* scratch(WorkspaceSlot slot, int mode, std::size_t rows,
+                       std::size_t cols)
+    {
+        auto& s = scratch_[static_cast<std::size_t>(slot)];
+        if (!s.matrix || s.mode != mode || s.rows != rows || s.cols < cols)
+        {
+            s.matrix = std::make_unique<Matrix<T>>(mode, rows, cols);
+            s.mode = mode;
+            s.rows = rows;
+            s.cols = cols;
+        }
+        return s.matrix.get();
+    }
+
+    Matrix<Single<T>> Hs() { return *Hs___.get(); }
+    Matrix<Single<T>> Cs() { return *Cs___.get(); }
+    Matrix<Single<T>> Bs() { return *Bs___.get(); }
     T* C_comm()
     {
         T* C;
@@ -770,8 +817,28 @@ public:
     }
 
 private:
+    //! Sizes the small temporaries of the workspace, which are known from
+    //! the local shape of `C` and `max_block`.
+    void reserve_workspace()
+    {
+        workspace_.reserve<T>(WorkspaceSlot::Tau, max_block_);
+        workspace_.reserve<T>(WorkspaceSlot::Column, rows_);
+        workspace_.reserve<T>(WorkspaceSlot::Block, max_block_ * max_block_);
+    }
+
+    struct Scratch
+    {
+        std::unique_ptr<Matrix<T>> matrix;
+        int mode = 0;
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+    };
+
     std::size_t ldh_;
     int mode_;
+    std::size_t rows_;
+    std::size_t cols_;
+    std::size_t max_block_;
 
     std::unique_ptr<Matrix<T>> H___;
     std::unique_ptr<Matrix<T>> C___;
@@ -782,6 +849,12 @@ private:
     std::unique_ptr<Matrix<Base<T>>> Resid___;
     std::unique_ptr<Matrix<Base<T>>> Ritzv___;
     std::unique_ptr<Matrix<T>> vv___;
+    std::unique_ptr<Matrix<Single<T>>> Hs___;
+    std::unique_ptr<Matrix<Single<T>>> Cs___;
+    std::unique_ptr<Matrix<Single<T>>> Bs___;
+    Workspace workspace_;
+    std::array<Scratch, static_cast<std::size_t>(WorkspaceSlot::Count)>
+        scratch_;
 };
 } // namespace mpi
 } // namespace chase
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <mpi.h>
+#include <random>
 #include <tuple>
 #include <vector>
 
@@ -74,9 +77,86 @@ std::pair<std::size_t, std::size_t> numroc(std::size_t n, std::size_t nb,
     return std::make_pair(numroc, nb_loc);
 }
 
+//! Placement of the ranks of the 2D grid onto the nodes of a machine.
+enum class GridPlacement
+{
+    Default, //!< the ranks take the grid positions in their order in `comm`
+    Row,     //!< the ranks of a node fill the grid rows, so that the row
+             //!< communicators stay within a node
+    Column   //!< the ranks of a node fill the grid columns, so that the
+             //!< column communicators stay within a node
+};
+
+//! Reads the placement of the grid from the environment variable
+//! `CHASE_GRID_PLACEMENT`, which is either `row` or `col`. With ScaLAPACK the
+//! placement is always GridPlacement::Default, as the BLACS grids assume the
+//! default order of the ranks.
+GridPlacement getGridPlacement()
+{
+#if !defined(HAS_SCALAPACK)
+    char* placement = getenv("CHASE_GRID_PLACEMENT");
+    if (placement != NULL)
+    {
+        if (strcmp(placement, "row") == 0)
+            return GridPlacement::Row;
+        if (strcmp(placement, "col") == 0)
+            return GridPlacement::Column;
+    }
+#endif
+    return GridPlacement::Default;
+}
+
+//! Reorders the ranks of `comm` into `ordered`, such that the ranks sharing
+//! a node take consecutive positions in the grid rows (or columns) for
+//! GridPlacement::Row (or GridPlacement::Column), with the grid positions
+//! numbered as in create2DGrid().
+void placeOnNodes(int row_dim, int col_dim, bool col_major,
+                  GridPlacement placement, MPI_Comm comm, MPI_Comm* ordered)
+{
+    int rank, nprocs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nprocs);
+
+    // the ranks sorted by node and by rank within a node
+    MPI_Comm node;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                        &node);
+    int node_rank, leader = rank;
+    MPI_Comm_rank(node, &node_rank);
+    MPI_Bcast(&leader, 1, MPI_INT, 0, node);
+    MPI_Comm_free(&node);
+
+    int mine[2] = {leader, node_rank};
+    std::vector<int> all(2 * nprocs);
+    MPI_Allgather(mine, 2, MPI_INT, all.data(), 2, MPI_INT, comm);
+    int pos = 0;
+    for (int r = 0; r < nprocs; r++)
+    {
+        if (all[2 * r] < leader ||
+            (all[2 * r] == leader && all[2 * r + 1] < node_rank))
+        {
+            pos++;
+        }
+    }
+
+    int myrow, mycol;
+    if (placement == GridPlacement::Row)
+    {
+        myrow = pos / col_dim;
+        mycol = pos % col_dim;
+    }
+    else
+    {
+        myrow = pos % row_dim;
+        mycol = pos / row_dim;
+    }
+    int key = col_major ? mycol * row_dim + myrow : myrow * col_dim + mycol;
+    MPI_Comm_split(comm, 0, key, ordered);
+}
+
 void create2DGrid(int row_dim, int col_dim, bool col_major, MPI_Comm comm,
                   MPI_Comm* row_comm_, MPI_Comm* col_comm_, int* myrow,
-                  int* mycol)
+                  int* mycol, GridPlacement placement = GridPlacement::Default)
 {
     int tmp_dims_[2];
     int dims_[2];
@@ -103,7 +183,17 @@ void create2DGrid(int row_dim, int col_dim, bool col_major, MPI_Comm comm,
     int rank_, nprocs_;
 
     MPI_Comm cartComm;
-    MPI_Cart_create(comm, 2, tmp_dims_, periodic, reorder, &cartComm);
+    if (placement != GridPlacement::Default)
+    {
+        MPI_Comm ordered;
+        placeOnNodes(row_dim, col_dim, col_major, placement, comm, &ordered);
+        MPI_Cart_create(ordered, 2, tmp_dims_, periodic, reorder, &cartComm);
+        MPI_Comm_free(&ordered);
+    }
+    else
+    {
+        MPI_Cart_create(comm, 2, tmp_dims_, periodic, reorder, &cartComm);
+    }
 
     MPI_Comm_size(cartComm, &nprocs_);
     MPI_Comm_rank(cartComm, &rank_);
@@ -297,7 +387,7 @@ public:
         isrc[1] = icsrc;
 
         create2DGrid(dims_[0], dims_[1], col_major, comm, &row_comm_,
-                     &col_comm_, &coord_[0], &coord_[1]);
+                     &col_comm_, &coord_[0], &coord_[1], getGridPlacement());
 
         for (std::size_t dim_idx = 0; dim_idx < 2; dim_idx++)
         {
@@ -515,6 +605,7 @@ public:
 #endif
         mpi_wrapper_.add(row_comm_, row_comm_dup);
         mpi_wrapper_.add(col_comm_, col_comm_dup);
+        addHierarchicalComms();
 
 #ifdef USE_NSIGHT
         nvtxRangePop();
@@ -617,7 +708,7 @@ public:
         }
 
         create2DGrid(dims_[0], dims_[1], col_major, comm, &row_comm_,
-                     &col_comm_, &coord_[0], &coord_[1]);
+                     &col_comm_, &coord_[0], &coord_[1], getGridPlacement());
 
         std::size_t len;
         len = m;
@@ -807,6 +898,7 @@ public:
 #endif
         mpi_wrapper_.add(row_comm_, row_comm_dup);
         mpi_wrapper_.add(col_comm_, col_comm_dup);
+        addHierarchicalComms();
 
 #ifdef USE_NSIGHT
         nvtxRangePop();
@@ -889,7 +981,7 @@ public:
 #endif
 
         create2DGrid(dims_[0], dims_[1], false, comm, &row_comm_, &col_comm_,
-                     &coord_[0], &coord_[1]);
+                     &coord_[0], &coord_[1], getGridPlacement());
 
         // size of local part of H
         int len;
@@ -1079,12 +1171,28 @@ public:
 #endif
         mpi_wrapper_.add(row_comm_, row_comm_dup);
         mpi_wrapper_.add(col_comm_, col_comm_dup);
+        addHierarchicalComms();
 
 #ifdef USE_NSIGHT
         nvtxRangePop();
 #endif
     }
 
+    ChaseMpiProperties(const ChaseMpiProperties&) = delete;
+
+    //! Releases the node-aware collectives, in the same order on all the
+    //! ranks.
+    ~ChaseMpiProperties()
+    {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+        {
+            mpi_wrapper_.free_hierarchical(row_comm_);
+            mpi_wrapper_.free_hierarchical(col_comm_);
+        }
+    }
+
     Comm_t get_mpi_wrapper() { return mpi_wrapper_; }
 #if defined(HAS_SCALAPACK)
     int get_colcomm_ctxt() { return colcomm_ctxt_; }
@@ -1157,6 +1265,11 @@ public:
      */
     MPI_Comm get_col_comm() { return col_comm_; }
 
+    /*!
+        \return `comm_`: the working MPI communicator of ChASE.
+     */
+    MPI_Comm get_comm() { return comm_; }
+
     //! Returns the dimension of cartesian communicator grid
     /*!
         \return `dims_`: an array of size 2 which store the dimensions of the
@@ -1627,7 +1740,219 @@ public:
         }	
     }
 
+    //! Generates the local part of the Hamiltonian matrix from its elements.
+    /*!
+      Every MPI rank evaluates `f(i, j)` for the global indices `(i, j)` of
+      the elements it owns, for *Block Distribution* as well as for
+      *Block-Cyclic Distribution*, without any communication or I/O. The
+      local columns are shared between the OpenMP threads, so `f` must be
+      safe to call concurrently.
+      @param f A callable returning the element `(i, j)` of the global
+      matrix as a `T`. ChASE requires the matrix to be Hermitian.
+      @param H Pointer to memory allocated for Hamiltonian matrix.
+    */
+    template <typename Func>
+    void generateHamiltonian(Func&& f, T* H)
+    {
+        std::vector<std::size_t> rows(m_), cols(n_);
+        for (std::size_t i = 0; i < mblocks_; i++)
+        {
+            for (std::size_t p = 0; p < r_lens_[i]; p++)
+            {
+                rows[r_offs_l_[i] + p] = r_offs_[i] + p;
+            }
+        }
+        for (std::size_t j = 0; j < nblocks_; j++)
+        {
+            for (std::size_t q = 0; q < c_lens_[j]; q++)
+            {
+                cols[c_offs_l_[j] + q] = c_offs_[j] + q;
+            }
+        }
+
+#pragma omp parallel for schedule(static)
+        for (std::size_t y = 0; y < n_; y++)
+        {
+            for (std::size_t x = 0; x < m_; x++)
+            {
+                H[x + m_ * y] = f(rows[x], cols[y]);
+            }
+        }
+    }
+
+    //! Generates the local part of the Hermitian matrix
+    //! `Q * diag(lambda) * Q^H`, where `Q` is the product of `nreflectors`
+    //! Householder reflectors of random unit vectors.
+    /*!
+      The vectors of the reflectors are drawn from `seed` by every MPI rank,
+      and their product is used in the compact WY form `Q = I - Y S Y^H`,
+      with `S` upper triangular. Hence with `D = diag(lambda)`
+
+          Q D Q^H = D - W A^H - A W^H + A M A^H,
+          A = Y S, W = D Y, M = Y^H D Y,
+
+      whose elements are computed by generateHamiltonian() in
+      `O(nreflectors)` operations each, after `O(N * nreflectors^2)`
+      operations on each rank. The elements below the diagonal are the
+      conjugates of the ones above it, and the diagonal is real, such that
+      the generated matrix is exactly Hermitian for any distribution.
+      @param lambda The `N` eigenvalues of the matrix.
+      @param H Pointer to memory allocated for Hamiltonian matrix.
+      @param nreflectors The number of Householder reflectors in `Q`.
+      @param seed The seed of the vectors of the reflectors, which must be
+      the same on all MPI ranks.
+    */
+    void generateHamiltonianSpectrum(const Base<T>* lambda, T* H,
+                                     std::size_t nreflectors = 2,
+                                     unsigned seed = 1337)
+    {
+        std::size_t k = nreflectors;
+        std::vector<T> Y(N_ * k), A(N_ * k, T(0)), W(N_ * k), B(N_ * k, T(0));
+        std::vector<T> S(k * k, T(0)), M(k * k, T(0));
+
+        std::mt19937 gen(seed);
+        std::normal_distribution<> d;
+        for (std::size_t b = 0; b < k; b++)
+        {
+            Base<T> norm = 0;
+            for (std::size_t i = 0; i < N_; i++)
+            {
+                Y[i + N_ * b] = getRandomT<T>([&]() { return d(gen); });
+                norm += std::norm(Y[i + N_ * b]);
+            }
+            for (std::size_t i = 0; i < N_; i++)
+            {
+                Y[i + N_ * b] /= std::sqrt(norm);
+            }
+        }
+
+        // S(b, b) = 2 and S(0:b, b) = -2 S(0:b, 0:b) Y(:, 0:b)^H Y(:, b), as
+        // in the forward accumulation of LAPACK xLARFT
+        std::vector<T> z(k);
+        for (std::size_t b = 0; b < k; b++)
+        {
+            for (std::size_t a = 0; a < b; a++)
+            {
+                z[a] = T(0);
+                for (std::size_t i = 0; i < N_; i++)
+                {
+                    z[a] += conjugate(Y[i + N_ * a]) * Y[i + N_ * b];
+                }
+            }
+            for (std::size_t a = 0; a < b; a++)
+            {
+                T sum = T(0);
+                for (std::size_t c = a; c < b; c++)
+                {
+                    sum += S[a + k * c] * z[c];
+                }
+                S[a + k * b] = T(-2) * sum;
+            }
+            S[b + k * b] = T(2);
+        }
+
+        for (std::size_t b = 0; b < k; b++)
+        {
+            for (std::size_t a = 0; a < k; a++)
+            {
+                for (std::size_t i = 0; i < N_; i++)
+                {
+                    M[a + k * b] +=
+                        conjugate(Y[i + N_ * a]) * lambda[i] * Y[i + N_ * b];
+                }
+            }
+        }
+        for (std::size_t b = 0; b < k; b++)
+        {
+            for (std::size_t i = 0; i < N_; i++)
+            {
+                W[i + N_ * b] = lambda[i] * Y[i + N_ * b];
+                for (std::size_t a = 0; a <= b; a++)
+                {
+                    A[i + N_ * b] += Y[i + N_ * a] * S[a + k * b];
+                }
+            }
+        }
+        for (std::size_t b = 0; b < k; b++)
+        {
+            for (std::size_t a = 0; a < k; a++)
+            {
+                for (std::size_t i = 0; i < N_; i++)
+                {
+                    B[i + N_ * b] += A[i + N_ * a] * M[a + k * b];
+                }
+            }
+        }
+
+        std::size_t N = N_;
+        auto upper = [&](std::size_t i, std::size_t j) {
+            T h = i == j ? T(lambda[i]) : T(0);
+            for (std::size_t b = 0; b < k; b++)
+            {
+                h -= W[i + N * b] * conjugate(A[j + N * b]) +
+                     A[i + N * b] * conjugate(W[j + N * b]) -
+                     B[i + N * b] * conjugate(A[j + N * b]);
+            }
+            return h;
+        };
+
+        generateHamiltonian(
+            [&](std::size_t i, std::size_t j) {
+                if (i < j)
+                {
+                    return upper(i, j);
+                }
+                else if (i > j)
+                {
+                    return conjugate(upper(j, i));
+                }
+                return T(std::real(upper(i, i)));
+            },
+            H);
+    }
+
+    //! Creates the file view of the vectors owned by this MPI rank.
+    /*!
+      The `N_ * max_block_` vectors are stored in column-major order in the
+      file, and the local part of size `m_ * max_block_` holds the rows which
+      are distributed as the rows of `H`, in the same order.
+      \return a committed MPI datatype, to be freed by the caller.
+    */
+    MPI_Datatype create_vectors_filetype()
+    {
+        std::size_t count = max_block_ * mblocks_;
+        std::vector<int> lens(count);
+        std::vector<MPI_Aint> displs(count);
+        for (std::size_t j = 0; j < max_block_; j++)
+        {
+            for (std::size_t i = 0; i < mblocks_; i++)
+            {
+                lens[j * mblocks_ + i] = static_cast<int>(r_lens_[i]);
+                displs[j * mblocks_ + i] =
+                    static_cast<MPI_Aint>((j * N_ + r_offs_[i]) * sizeof(T));
+            }
+        }
+
+        MPI_Datatype filetype;
+        MPI_Type_create_hindexed(static_cast<int>(count), lens.data(),
+                                 displs.data(), getMPI_Type<T>(), &filetype);
+        MPI_Type_commit(&filetype);
+        return filetype;
+    }
+
 private:
+    //! Sets up the node-aware collectives (HIER_BACKEND) over the row and
+    //! column communicators if the environment variable
+    //! `CHASE_HIERARCHICAL_COLLECTIVES` is set.
+    void addHierarchicalComms()
+    {
+        if (getenv("CHASE_HIERARCHICAL_COLLECTIVES") != NULL)
+        {
+            mpi_wrapper_.add_hierarchical(row_comm_);
+            mpi_wrapper_.add_hierarchical(col_comm_);
+        }
+    }
+
     ///////////////////////////////////////////////////
     // General parameters of the eigenproblem
     //////////////////////////////////////////////////
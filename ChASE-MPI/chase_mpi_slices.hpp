@@ -0,0 +1,316 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <mpi.h>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include "algorithm/algorithm.hpp"
+
+namespace chase
+{
+namespace mpi
+{
+
+//! @brief Spectrum slicing: the slices of an interval of the spectrum are
+//! solved concurrently by disjoint groups of MPI ranks.
+/*!
+  The ranks of a communicator are split into `nslices` groups of consecutive
+  ranks, see get_slice_comm(). Each group builds its own ChaseMpiProperties
+  on this communicator, with the whole matrix distributed over its own 2D
+  grid, and its ChaseMpi solves one slice. The collectives of a solve thus
+  stay within a group, and the groups only meet in partition() and
+  gather().
+
+  partition() chooses the boundaries of the slices from the density of
+  states (DoS) estimated by the Lanczos procedures of each group, such that
+  the slices hold about the same number of eigenvalues, and sets the slice of
+  the group with ChaseConfig::SetInterval(). A slice is only solved
+  completely if `nev` is at least its number of eigenvalues, get_nev() is
+  the estimate with a margin for the error of the DoS.
+
+  After the solves, gather() assembles the eigenvalues of the whole
+  interval: each group contributes its converged eigenpairs within its
+  slice, and an eigenpair found by two neighbouring groups at their common
+  boundary is kept once. is_complete() tells whether every slice was found
+  completely, that is whether each group converged `nev` eigenpairs
+  reaching beyond its slice.
+*/
+template <class T>
+class ChaseMpiSlices
+{
+public:
+    //! Splits the ranks of `comm` into `nslices` groups, with
+    //! `1 <= nslices <= size(comm)`.
+    ChaseMpiSlices(MPI_Comm comm, int nslices)
+        : comm_(comm), nslices_(nslices)
+    {
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        assert(nslices >= 1 && nslices <= size);
+        slice_ = static_cast<int>(static_cast<long>(rank) * nslices / size);
+        MPI_Comm_split(comm, slice_, rank, &slice_comm_);
+    }
+
+    ChaseMpiSlices(const ChaseMpiSlices&) = delete;
+
+    ~ChaseMpiSlices()
+    {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+        {
+            MPI_Comm_free(&slice_comm_);
+        }
+    }
+
+    //! Returns the communicator of the group of this rank, on which its
+    //! ChaseMpiProperties is built.
+    MPI_Comm get_slice_comm() { return slice_comm_; }
+    //! Returns the index of the slice of this rank.
+    int get_slice() const { return slice_; }
+    //! Returns the number of slices.
+    int get_nslices() const { return nslices_; }
+    //! Returns the `nslices+1` boundaries of the slices set by partition().
+    const std::vector<Base<T>>& get_bounds() const { return bounds_; }
+    //! Returns the estimated number of eigenvalues per slice.
+    double get_count() const { return count_; }
+    //! Returns the `nev` which covers the estimated number of eigenvalues of
+    //! a slice, with a margin of 20% for the error of the estimate.
+    std::size_t get_nev() const
+    {
+        return static_cast<std::size_t>(std::ceil(1.2 * count_)) + 1;
+    }
+    //! Returns whether gather() found all the eigenvalues of every slice.
+    bool is_complete() const { return complete_; }
+    //! Returns the columns of the eigenvectors of this group, in the vectors
+    //! of its solver, of the eigenvalues it contributed to gather(), in
+    //! ascending order of the eigenvalues.
+    const std::vector<std::size_t>& get_columns() const { return columns_; }
+
+    //! Splits `[lower, upper]` into slices holding about the same number of
+    //! eigenvalues, and sets the slice of this group to the configuration of
+    //! `single`, its solver. It is collective over the communicator of the
+    //! constructor.
+    void partition(Chase<T>* single, Base<T> lower, Base<T> upper)
+    {
+        ChaseConfig<T>& config = single->GetConfig();
+        std::size_t N = config.GetN();
+        std::size_t nevex = config.GetNev() + config.GetNex();
+        int numvec = config.GetNumLanczos();
+        int m = std::min(nevex, std::min(N / 2, config.GetLanczosIter()));
+
+        Workspace& ws = single->GetWorkspace();
+        Base<T>* Theta = ws.template zeros<Base<T>>(
+            WorkspaceSlot::LanczosTheta, numvec * m);
+        Base<T>* Tau =
+            ws.template zeros<Base<T>>(WorkspaceSlot::LanczosTau, numvec * m);
+        Base<T>* ritzV =
+            ws.template zeros<Base<T>>(WorkspaceSlot::LanczosRitzV, m * m);
+        Base<T> upperb;
+
+        single->Start();
+        single->initVecs(true);
+        single->Lanczos(m, numvec, &upperb, Theta, Tau, ritzV);
+        single->End();
+
+        // the number of eigenvalues below the points of a grid of the
+        // interval, averaged over the estimates of all the groups
+        int size;
+        MPI_Comm_size(comm_, &size);
+        std::size_t npoints = std::max(1024, 64 * nslices_);
+        std::vector<double> below(npoints + 1);
+        for (std::size_t i = 0; i <= npoints; i++)
+        {
+            double x = lower + (upper - lower) * i / npoints;
+            below[i] = Algorithm<T>::dos_spread(x, Theta, Tau, numvec, m);
+        }
+        MPI_Allreduce(MPI_IN_PLACE, below.data(), npoints + 1, MPI_DOUBLE,
+                      MPI_SUM, comm_);
+        for (auto& c : below)
+        {
+            c = N * c / size;
+        }
+
+        // the boundaries at equal counts, interpolated within the grid
+        double total = below[npoints] - below[0];
+        count_ = total / nslices_;
+        bounds_.assign(nslices_ + 1, lower);
+        bounds_[nslices_] = upper;
+        std::size_t i = 0;
+        for (int k = 1; k < nslices_; k++)
+        {
+            if (total <= 0)
+            {
+                bounds_[k] = lower + (upper - lower) * k / nslices_;
+                continue;
+            }
+            double target = below[0] + total * k / nslices_;
+            while (i < npoints - 1 && below[i + 1] < target)
+            {
+                i++;
+            }
+            double w = (target - below[i]) / (below[i + 1] - below[i]);
+            w = std::min(std::max(w, 0.0), 1.0);
+            bounds_[k] = lower + (upper - lower) * (i + w) / npoints;
+        }
+
+        config.SetInterval(bounds_[slice_], bounds_[slice_ + 1]);
+
+#ifdef CHASE_OUTPUT
+        {
+            std::ostringstream oss;
+            oss << "spectrum slices of about " << count_ << " eigenvalues:";
+            for (auto b : bounds_)
+            {
+                oss << " " << b;
+            }
+            oss << "\n";
+            if (get_nev() > config.GetNev())
+            {
+                oss << "nev is below the estimated number of eigenvalues of "
+                       "a slice, " << get_nev() << " are advised\n";
+            }
+            single->Output(oss.str());
+        }
+#endif
+    }
+
+    //! Returns the eigenvalues of the interval of partition() found by all
+    //! the groups, in ascending order, after `single` solved the slice of
+    //! this group. It is collective over the communicator of the
+    //! constructor.
+    /*!
+      A group contributes its converged eigenpairs of its slice, widened by
+      their residuals: an eigenvalue of the slice is within the residual of
+      its Ritz value. An eigenvalue of the boundary of two slices may then be
+      found by both groups, the pairs of neighbouring groups which are
+      within the sum of their residuals are matched one to one, and the
+      one of the upper group is dropped.
+     */
+    std::vector<Base<T>> gather(Chase<T>* single)
+    {
+        ChaseConfig<T>& config = single->GetConfig();
+        std::size_t nev = config.GetNev();
+        Base<T>* ritzv = single->GetRitzv();
+        Base<T>* resid = single->GetResid();
+        Base<T> lower = bounds_.front();
+        Base<T> upper = bounds_.back();
+        Base<T> lo = bounds_[slice_];
+        Base<T> hi = bounds_[slice_ + 1];
+
+        // the candidates of this group: value, residual, slice and column,
+        // contributed by the first rank of the group only
+        int slice_rank;
+        MPI_Comm_rank(slice_comm_, &slice_rank);
+        std::vector<double> mine;
+        std::size_t nconv = 0;
+        Base<T> reach = 0;
+        for (std::size_t i = 0; i < nev; i++)
+        {
+            if (resid[i] > config.GetTol())
+            {
+                continue;
+            }
+            nconv++;
+            reach = std::max(reach, std::abs(ritzv[i] - (lo + hi) / 2));
+            if (slice_rank == 0 && ritzv[i] >= lo - resid[i] &&
+                ritzv[i] <= hi + resid[i] && ritzv[i] >= lower &&
+                ritzv[i] <= upper)
+            {
+                mine.insert(mine.end(), {double(ritzv[i]), double(resid[i]),
+                                         double(slice_), double(i)});
+            }
+        }
+
+        // a slice is complete if the nev eigenvalues closest to its center
+        // reach beyond it
+        int complete = nconv == nev && reach > (hi - lo) / 2;
+        MPI_Allreduce(MPI_IN_PLACE, &complete, 1, MPI_INT, MPI_LAND, comm_);
+        complete_ = complete;
+
+        int size;
+        MPI_Comm_size(comm_, &size);
+        int len = mine.size();
+        std::vector<int> lens(size), displs(size, 0);
+        MPI_Allgather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, comm_);
+        for (int r = 1; r < size; r++)
+        {
+            displs[r] = displs[r - 1] + lens[r - 1];
+        }
+        std::vector<double> all(displs[size - 1] + lens[size - 1]);
+        MPI_Allgatherv(mine.data(), len, MPI_DOUBLE, all.data(), lens.data(),
+                       displs.data(), MPI_DOUBLE, comm_);
+
+        std::size_t n = all.size() / 4;
+        std::vector<std::size_t> index(n);
+        std::iota(index.begin(), index.end(), 0);
+        std::stable_sort(index.begin(), index.end(),
+                         [&](std::size_t a, std::size_t b) {
+                             return all[4 * a] < all[4 * b];
+                         });
+
+        // the pairs of neighbouring slices are matched one to one, and the
+        // one of the upper slice is dropped
+        std::vector<bool> paired(n, false), dropped(n, false);
+        for (std::size_t k = 0; k < n; k++)
+        {
+            std::size_t a = index[k];
+            for (std::size_t l = k; l-- > 0;)
+            {
+                std::size_t b = index[l];
+                if (all[4 * a] - all[4 * b] > all[4 * a + 1] + all[4 * b + 1])
+                {
+                    break;
+                }
+                if (std::abs(all[4 * a + 2] - all[4 * b + 2]) == 1 &&
+                    !paired[b])
+                {
+                    paired[a] = paired[b] = true;
+                    dropped[all[4 * a + 2] > all[4 * b + 2] ? a : b] = true;
+                    break;
+                }
+            }
+        }
+
+        std::vector<Base<T>> lambda;
+        columns_.clear();
+        for (auto k : index)
+        {
+            if (dropped[k])
+            {
+                continue;
+            }
+            lambda.push_back(all[4 * k]);
+            if (int(all[4 * k + 2]) == slice_)
+            {
+                columns_.push_back(std::size_t(all[4 * k + 3]));
+            }
+        }
+        return lambda;
+    }
+
+private:
+    MPI_Comm comm_;              //!< the communicator of all the groups
+    MPI_Comm slice_comm_;        //!< the communicator of this group
+    int nslices_;                //!< number of slices
+    int slice_;                  //!< the slice of this group
+    std::vector<Base<T>> bounds_; //!< boundaries of the slices
+    double count_ = 0;           //!< estimated eigenvalues per slice
+    bool complete_ = false;      //!< all the slices found completely
+    std::vector<std::size_t> columns_; //!< columns gathered from this group
+};
+
+} // namespace mpi
+} // namespace chase
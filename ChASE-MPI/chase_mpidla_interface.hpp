@@ -9,7 +9,9 @@
 
 #include <cstdlib>
 #include <tuple>
+#include <vector>
 
+#include "algorithm/random.hpp"
 #include "algorithm/types.hpp"
 #include "chase_mpi_matrices.hpp"
 #include "chase_mpi_properties.hpp"
@@ -26,6 +28,40 @@ struct is_skewed_matrixfree
     static const bool value = false;
 };
 
+//! Applies in place the column permutation `perm` by following its cycles.
+/*! After the call, column `k` holds what was column `perm[k]` before. Each
+    moved column is copied once, plus twice per cycle through a scratch
+    column.
+    @param perm: a permutation of `0, ..., perm.size()-1`.
+    @param copy: a callable `copy(dst, src)` copying the column `src` into
+    the column `dst`, in which the index `perm.size()` denotes the scratch
+    column.
+*/
+template <typename F>
+void permute_columns(const std::vector<std::size_t>& perm, F copy)
+{
+    std::size_t scratch = perm.size();
+    std::vector<bool> done(perm.size(), false);
+
+    for (std::size_t k = 0; k < perm.size(); k++)
+    {
+        if (done[k] || perm[k] == k)
+        {
+            continue;
+        }
+        copy(scratch, k);
+        std::size_t i = k;
+        while (perm[i] != k)
+        {
+            copy(i, perm[i]);
+            done[i] = true;
+            i = perm[i];
+        }
+        copy(i, scratch);
+        done[i] = true;
+    }
+}
+
 //! @brief A class to set up an interface to all the Dense Linear Algebra
 //! (`DLA`) operations required by ChASE.
 /*!
@@ -112,6 +148,35 @@ public:
     virtual void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                        std::size_t locked) = 0;
 
+    //! Performs apply() on a chunk of the `block` vectors of one step.
+    /*! A step of the filter can be split into consecutive chunks of
+        columns, so that the communication of a chunk overlaps with the
+        computation of the following ones. The switch between `V2 = H * V1`
+        and `V1 = H^H * V2` only happens after the `last` chunk, on which all
+        the pending communications are completed as well.
+        @param offset: the offset of the chunk, from the `locked` vectors.
+        @param block: the number of vectors of the chunk.
+        @param last: if it is the last chunk of the step.
+    */
+    virtual void applyChunk(T alpha, T beta, std::size_t offset,
+                            std::size_t block, std::size_t locked,
+                            bool last) = 0;
+
+    //! Switches the following calls of apply() to single precision.
+    /*! The matrix (if it has been modified since the previous call within
+        the same solve) and the non-converged vectors are copied into the
+        single-precision buffers of ChaseMpiMatrices.
+        @param locked: number of converged eigenvectors.
+        \return `false` if it is not supported by the implementation, then
+        apply() keeps running in the working precision.
+    */
+    virtual bool enterSinglePrecision(std::size_t locked) = 0;
+
+    //! Copies the vectors filtered in single precision back into the working
+    //! buffers, and switches apply() back to the working precision.
+    //! @param locked: number of converged eigenvectors.
+    virtual void leaveSinglePrecision(std::size_t locked) = 0;
+
     //! Performs \f$V_2<- V1H + V_2\f$
     /*!
       The number of vectors performed in `V1` and `V2` is `block`
@@ -140,6 +205,13 @@ public:
      */
     virtual void Swap(std::size_t i, std::size_t j) = 0;
 
+    //! Reorders the columns of the matrices of vectors, in a single pass.
+    /*!
+     *  @param perm: a permutation of `0, ..., nev+nex-1`, the column `k`
+     *  receives the former column `perm[k]`.
+     */
+    virtual void Permute(const std::vector<std::size_t>& perm) = 0;
+
     //! Performs a Generalized Matrix Vector Multiplication (`GEMV`) with
     //! `alpha=1.0` and `beta=0.0`.
     /*!
@@ -315,6 +387,19 @@ public:
     virtual void Resd(Base<T>* ritzv, Base<T>* resid, std::size_t locked,
                       std::size_t unconverged) = 0;
 
+    //! Fused **Rayleigh-Ritz** and residual computation.
+    //! Since \f$H(C_2Q) = (HC_2)Q\f$, the product `H*C2` formed by RR is
+    //! rotated by the small eigenvector matrix `Q` of the reduced problem
+    //! instead of being recomputed, which saves one `H*C` product (and its
+    //! collective communication) per subspace iteration.
+    //! @param block the number of unconverged ritz pairs
+    //! (`=nev_+nex-locked`)
+    //! @param locked the number of converged ritz values
+    //! @param ritzv the computed ritz values
+    //! @param resid the computed residuals
+    virtual void RRResd(std::size_t block, std::size_t locked,
+                        Base<T>* ritzv, Base<T>* resid) = 0;
+
     //! Househoulder QR factorization on the rectangular matrix `V1`.
     //! It can be geqrf from
     //!     - `LAPACK` ,
@@ -325,8 +410,16 @@ public:
     //! the implementation and targeting architectures.
     //!  @param locked: number of converged eigenvectors.
     virtual void hhQR(std::size_t locked) = 0;
-    //! Cholesky QR factorization on the rectangular matrix `V1`.
+    //! Communication-avoiding Householder QR factorization (TSQR) on the
+    //! rectangular matrix `V1`, whose `R` factors are reduced along a tree
+    //! over the MPI ranks holding the rows of `V1`. It is the same as hhQR()
+    //! if all the rows are local.
     //!  @param locked: number of converged eigenvectors.
+    virtual void tsQR(std::size_t locked) = 0;
+    //! Cholesky QR factorization on the rectangular matrix `V1`.
+    //!  @param locked: number of leading converged eigenvectors, which are
+    //!  orthonormal. An implementation may orthogonalize the other columns
+    //!  against them and factorize only those, or factorize all the columns.
     virtual int cholQR1(std::size_t locked) = 0;
     virtual int cholQR2(std::size_t locked) = 0;
     virtual int shiftedcholQR2(std::size_t locked) = 0;
@@ -339,8 +339,16 @@ public:
             memcpy_mode[0] = CPY_H2H;
             memcpy_mode[1] = CPY_H2H;
             memcpy_mode[2] = CPY_H2H;
-            allreduce_backend = MPI_BACKEND;
-            bcast_backend = MPI_BACKEND;
+            if (mpi_wrapper_.is_hierarchical())
+            {
+                allreduce_backend = HIER_BACKEND;
+                bcast_backend = HIER_BACKEND;
+            }
+            else
+            {
+                allreduce_backend = MPI_BACKEND;
+                bcast_backend = MPI_BACKEND;
+            }
         }
 
         if (!isSameDist_)
@@ -387,23 +395,13 @@ public:
     }
 
     //! generating initial random vectors when it is necessary
-    //!     - different MPI proc/GPUs generate parts of the required random
-    //!     numbers
-    //!     - MPI proc/GPUs with the same rank within the same column
-    //!     communicator
-    //!       share the same seed of RNG (random number generator)
-    //!     - the generation of random numbers taking place within
-    //!     ChaseMpiDLABlaslapack::initRndVecs()
-    //!       and ChaseMpiDLAMultiGPU::initRndVecs(), targetting different
-    //!       architectures
-    //!         - in ChaseMpiDLABlaslapack, random numbers on each MPI rank is
-    //!         generated in
-    //!           sequence with C++ STL random generator
-    //!         - in ChaseMpiDLAMultiGPU, random numbers on each MPI rank is
-    //!         generated in parallel
-    //!           on related GPU based on the device API of <a
-    //!           href="https://docs.nvidia.com/c
-    //! uda/curand/index.html">cuRAND</a>.
+    //!     - each MPI proc/GPU generates the random numbers of its local
+    //!     rows within ChaseMpiDLABlaslapack::initRndVecs() or
+    //!     ChaseMpiDLAMultiGPU::initRndVecs()
+    //!     - the random numbers are generated on the host with the
+    //!     counter-based ChaseRandom, keyed by the global row and column
+    //!     indices, such that the initial vectors are the same for any MPI
+    //!     grid and any backend
     void initRndVecs() override
     {
 #ifdef USE_NSIGHT
@@ -440,14 +438,24 @@ public:
 
         // T *C_host;
         // dla_->retrieveC(&C_host, locked, block, false);
-        for (auto j = 0; j < block; j++)
+        T* C = matrices_->C().ptr() + locked * m_;
+        if (mblocks_ == 1)
+        {
+            t_lacpy_par(r_lens_[0], block, V + locked * N_ + r_offs_[0], N_,
+                        C, m_);
+        }
+        else
         {
-            for (auto i = 0; i < mblocks_; i++)
+#pragma omp parallel for collapse(2) schedule(static)                          \
+    if (m_ * block * sizeof(T) >= t_copy_threshold())
+            for (std::size_t j = 0; j < block; j++)
             {
-                std::memcpy(matrices_->C().ptr() + j * m_ + r_offs_l_[i] +
-                                locked * m_,
-                            V + j * N_ + locked * N_ + r_offs_[i],
-                            r_lens_[i] * sizeof(T));
+                for (std::size_t i = 0; i < mblocks_; i++)
+                {
+                    std::memcpy(C + j * m_ + r_offs_l_[i],
+                                V + j * N_ + locked * N_ + r_offs_[i],
+                                r_lens_[i] * sizeof(T));
+                }
             }
         }
 
@@ -500,8 +508,19 @@ public:
             nvtxRangePop();
             nvtxRangePushA("ChaseMpiDLA: allreduce");
 #endif
-            AllReduce(allreduce_backend, B + locked * n_ + offset * n_, dim,
-                      getMPI_Type<T>(), MPI_SUM, col_comm_, mpi_wrapper_);
+            if (single_)
+            {
+                AllReduce(allreduce_backend,
+                          matrices_->Bs().ptr() + locked * n_ + offset * n_,
+                          dim, getMPI_Type<Single<T>>(), MPI_SUM, col_comm_,
+                          mpi_wrapper_);
+            }
+            else
+            {
+                AllReduce(allreduce_backend, B + locked * n_ + offset * n_,
+                          dim, getMPI_Type<T>(), MPI_SUM, col_comm_,
+                          mpi_wrapper_);
+            }
 #ifdef USE_NSIGHT
             nvtxRangePop();
 #endif
@@ -519,8 +538,19 @@ public:
             nvtxRangePop();
             nvtxRangePushA("ChaseMpiDLA: allreduce");
 #endif
-            AllReduce(allreduce_backend, C + locked * m_ + offset * m_, dim,
-                      getMPI_Type<T>(), MPI_SUM, row_comm_, mpi_wrapper_);
+            if (single_)
+            {
+                AllReduce(allreduce_backend,
+                          matrices_->Cs().ptr() + locked * m_ + offset * m_,
+                          dim, getMPI_Type<Single<T>>(), MPI_SUM, row_comm_,
+                          mpi_wrapper_);
+            }
+            else
+            {
+                AllReduce(allreduce_backend, C + locked * m_ + offset * m_,
+                          dim, getMPI_Type<T>(), MPI_SUM, row_comm_,
+                          mpi_wrapper_);
+            }
 #ifdef USE_NSIGHT
             nvtxRangePop();
 #endif
@@ -531,6 +561,68 @@ public:
 #endif
     }
 
+    /*!
+       - In ChaseMpiDLA, the product of each chunk is reduced with a
+       non-blocking `MPI_Iallreduce`, which progresses while the local `GEMM`
+       of the following chunks is computed. All the reductions of the step
+       are completed with the `last` chunk.
+       - With NCCL, the reductions remain blocking.
+       - For the meaning of this function, please visit ChaseMpiDLAInterface.
+    */
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
+    {
+#ifdef USE_NSIGHT
+        nvtxRangePushA("ChaseMpiDLA: applyChunk");
+#endif
+        bool bAc = (next_ == NextOp::bAc);
+        std::size_t ld = bAc ? n_ : m_;
+        MPI_Comm comm = bAc ? col_comm_ : row_comm_;
+
+        dla_->applyChunk(alpha, beta, offset, block, locked, last);
+
+        if (single_)
+        {
+            Single<T>* buf = bAc ? matrices_->Bs().ptr() : matrices_->Cs().ptr();
+            allreduceChunk(buf + (locked + offset) * ld, ld * block, comm);
+        }
+        else
+        {
+            allreduceChunk((bAc ? B : C) + (locked + offset) * ld, ld * block,
+                           comm);
+        }
+
+        if (last)
+        {
+            ChaseCommStats::Scope comm_stats;
+            MPI_Waitall(pending_reqs_.size(), pending_reqs_.data(),
+                        MPI_STATUSES_IGNORE);
+            pending_reqs_.clear();
+            next_ = bAc ? NextOp::cAb : NextOp::bAc;
+        }
+#ifdef USE_NSIGHT
+        nvtxRangePop();
+#endif
+    }
+
+    //! - In ChaseMpiDLA, the local buffers are converted by
+    //! ChaseMpiDLABlaslapack, while the following allreduce operations of
+    //! apply() are performed in single precision as well, which halves the
+    //! communication volume of the filter.
+    //! - For the meaning of this function, please visit ChaseMpiDLAInterface.
+    bool enterSinglePrecision(std::size_t locked) override
+    {
+        single_ = dla_->enterSinglePrecision(locked);
+        return single_;
+    }
+
+    //! For the meaning of this function, please visit ChaseMpiDLAInterface.
+    void leaveSinglePrecision(std::size_t locked) override
+    {
+        dla_->leaveSinglePrecision(locked);
+        single_ = false;
+    }
+
     //! collect partially distributed matrices into redundant matrices
     //! @param buff the sending buff
     //! @param targetBuf the receiving buff
@@ -542,15 +634,7 @@ public:
     void collecRedundantVecs(T* buff, T* targetBuf, std::size_t dimsIdx,
                              std::size_t block)
     {
-        MPI_Comm comm;
-        if (dimsIdx == 0)
-        {
-            comm = col_comm_;
-        }
-        else if (dimsIdx == 1)
-        {
-            comm = row_comm_;
-        }
+        MPI_Comm comm = dimsIdx == 0 ? col_comm_ : row_comm_;
         int rank;
         MPI_Comm_rank(comm, &rank);
 
@@ -564,35 +648,45 @@ public:
             }
         }
 
-        if (data_layout.compare("Block-Cyclic") == 0)
         {
+            ChaseCommStats::Scope comm_stats;
             for (auto i = 0; i < dims_[dimsIdx]; i++)
             {
-                if (rank == i)
-                {
-                    MPI_Ibcast(buff, send_lens_[dimsIdx][i] * block,
-                               getMPI_Type<T>(), i, comm, &reqs[i]);
-                }
-                else
-                {
-                    MPI_Ibcast(Buff_.data(), block, newType_[dimsIdx][i], i,
-                               comm, &reqs[i]);
-                }
+                comm_stats.count(
+                    rank == i ? send_lens_[dimsIdx][i] * block * sizeof(T)
+                              : typeBytes(newType_[dimsIdx][i], block));
             }
-        }
-        else
-        {
-            for (auto i = 0; i < dims_[dimsIdx]; i++)
+
+            if (data_layout.compare("Block-Cyclic") == 0)
             {
-                if (rank == i)
+                for (auto i = 0; i < dims_[dimsIdx]; i++)
                 {
-                    MPI_Ibcast(buff, send_lens_[dimsIdx][i] * block,
-                               getMPI_Type<T>(), i, comm, &reqs[i]);
+                    if (rank == i)
+                    {
+                        MPI_Ibcast(buff, send_lens_[dimsIdx][i] * block,
+                                   getMPI_Type<T>(), i, comm, &reqs[i]);
+                    }
+                    else
+                    {
+                        MPI_Ibcast(Buff_.data(), block, newType_[dimsIdx][i],
+                                   i, comm, &reqs[i]);
+                    }
                 }
-                else
+            }
+            else
+            {
+                for (auto i = 0; i < dims_[dimsIdx]; i++)
                 {
-                    MPI_Ibcast(targetBuf, block, newType_[dimsIdx][i], i, comm,
-                               &reqs[i]);
+                    if (rank == i)
+                    {
+                        MPI_Ibcast(buff, send_lens_[dimsIdx][i] * block,
+                                   getMPI_Type<T>(), i, comm, &reqs[i]);
+                    }
+                    else
+                    {
+                        MPI_Ibcast(targetBuf, block, newType_[dimsIdx][i], i,
+                                   comm, &reqs[i]);
+                    }
                 }
             }
         }
@@ -601,36 +695,48 @@ public:
 
         if (data_layout.compare("Block-Cyclic") == 0)
         {
-            for (auto j = 0; j < block; ++j)
-            {
-                std::memcpy(Buff_.data() + j * N_ +
-                                block_cyclic_displs_[dimsIdx][i][0],
-                            buff + send_lens_[dimsIdx][i] * j,
-                            send_lens_[dimsIdx][i] * sizeof(T));
-            }
+            t_lacpy_par(send_lens_[dimsIdx][i], block, buff,
+                        send_lens_[dimsIdx][i],
+                        Buff_.data() + block_cyclic_displs_[dimsIdx][i][0], N_);
         }
         else
         {
-            for (auto j = 0; j < block; ++j)
-            {
-                std::memcpy(targetBuf + j * N_ +
-                                block_cyclic_displs_[dimsIdx][i][0],
-                            buff + send_lens_[dimsIdx][i] * j,
-                            send_lens_[dimsIdx][i] * sizeof(T));
-            }
+            t_lacpy_par(send_lens_[dimsIdx][i], block, buff,
+                        send_lens_[dimsIdx][i],
+                        targetBuf + block_cyclic_displs_[dimsIdx][i][0], N_);
         }
 
-        MPI_Waitall(dims_[dimsIdx], reqs.data(), MPI_STATUSES_IGNORE);
+        {
+            ChaseCommStats::Scope comm_stats;
+            MPI_Waitall(dims_[dimsIdx], reqs.data(), MPI_STATUSES_IGNORE);
+        }
 
         if (data_layout.compare("Block-Cyclic") == 0)
         {
+            // the columns of all the blocks of all the ranks are copied in
+            // parallel, as the blocks are too small to be split
+            std::vector<std::pair<int, int>> blocks;
             for (auto j = 0; j < dims_[dimsIdx]; j++)
             {
                 for (auto i = 0; i < block_counts_[dimsIdx][j]; ++i)
                 {
-                    t_lacpy('A', blocklens_[dimsIdx][j][i], block,
-                            Buff_.data() + block_cyclic_displs_[dimsIdx][j][i],
-                            N_, targetBuf + blockdispls_[dimsIdx][j][i], N_);
+                    blocks.emplace_back(j, i);
+                }
+            }
+
+#pragma omp parallel for collapse(2) schedule(static)                          \
+    if (N_ * block * sizeof(T) >= t_copy_threshold())
+            for (std::size_t k = 0; k < blocks.size(); k++)
+            {
+                for (std::size_t q = 0; q < block; q++)
+                {
+                    int j = blocks[k].first;
+                    int i = blocks[k].second;
+                    std::memcpy(
+                        targetBuf + blockdispls_[dimsIdx][j][i] + q * N_,
+                        Buff_.data() + block_cyclic_displs_[dimsIdx][j][i] +
+                            q * N_,
+                        blocklens_[dimsIdx][j][i] * sizeof(T));
                 }
             }
         }
@@ -689,13 +795,10 @@ public:
                     }
                 }
             }
-            for (auto i = 0; i < col_size_; i++)
+            if (row_rank_ == col_rank_)
             {
-                if (row_rank_ == col_rank_)
-                {
-                    dla_->lacpy('A', m_, block, C2 + locked * m_, m_,
-                                B2 + locked * n_, n_);
-                }
+                dla_->lacpy('A', m_, block, C2 + locked * m_, m_,
+                            B2 + locked * n_, n_);
             }
         }
         else
@@ -771,21 +874,17 @@ public:
 
     bool checkSymmetryEasy() override
     {
+        if (matrices_->H().host() == nullptr)
+        {
+            return checkSymmetryBilinear();
+        }
+
         std::vector<T> v(m_, T(0.0));
         std::vector<T> u(n_, T(0.0));
         std::vector<T> uT(m_, T(0.0));
         std::vector<T> v_2(n_, T(0.0));
 
-        int mpi_col_rank;
-        MPI_Comm_rank(col_comm_, &mpi_col_rank);
-
-        std::mt19937 gen(1337.0 + mpi_col_rank);
-        std::normal_distribution<> d;
-
-        for (auto i = 0; i < m_; i++)
-        {
-            v[i] = getRandomT<T>([&]() { return d(gen); });
-        }
+        this->fillRandom(1, v.data(), m_, 0);
 
         this->C2B(v.data(), 0, v_2.data(), 0, 1);
 
@@ -847,6 +946,10 @@ public:
     void symOrHermMatrix(char uplo) override
     {
 #if defined(HAS_SCALAPACK)
+        if (matrices_->H().host() == nullptr)
+        {
+            return;
+        }
         auto ctxt = matrix_properties_->get_comm2D_ctxt();
         std::size_t desc_H[9];
         int info;
@@ -1004,8 +1107,7 @@ public:
         nvtxRangePop();
         nvtxRangePushA("allreduce");
 #endif
-        AllReduce(allreduce_backend, A, (nev_ + nex_) * block, getMPI_Type<T>(),
-                  MPI_SUM, row_comm_, mpi_wrapper_);
+        this->allreduceHermitian('L', block, nev_ + nex_, row_comm_);
 
 #ifdef USE_NSIGHT
         nvtxRangePop();
@@ -1041,28 +1143,32 @@ public:
         nvtxRangePushA("allreduce");
 #endif
 
-        AllReduce(allreduce_backend, rsd + locked, unconverged,
-                  getMPI_Type<Base<T>>(), MPI_SUM, row_comm_, mpi_wrapper_);
-//  Base<T> *resid_h;
-// dla_->retrieveResid(&resid_h, locked, unconverged);
-#if defined(HAS_UM)
-        matrices_->Resid().sync2Ptr(1, unconverged, locked);
-#else
-        if (rsd != matrices_->Resid().ptr())
-        {
-            //	std::cout << "rsd != Resid().ptr()" << std::endl;
-            matrices_->Resid().sync2Ptr(1, unconverged, locked);
-        }
+        this->gatherResids(resid, locked, unconverged);
+    }
+
+    /*! Implementation of the fused Rayleigh-Ritz and residual computation
+     * - The workflow is the one of RR(), followed by
+     *     - `gemm`: `W = B_*A_` and `B_ = B2_*A_` (local computation), i.e.,
+     `H*C_` and `C_` of the new ritz vectors in the layout of `B_`
+     *     - the local part of the residuals from `W - B_*diag(ritzv)`
+     *     - `allreduce`(resid, MPI_SUM) (within row communicator)
+     * - Compared with RR() followed by Resd(), the second call to
+     asynCxHGatherC() (one `H*C_` product and one `allreduce` within the
+     column communicator) is avoided.
+   */
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        this->RR(block, locked, ritzv);
+#ifdef USE_NSIGHT
+        nvtxRangePushA("ChaseMpiDLA: RRResd");
 #endif
+        dla_->RRResd(block, locked, ritzv, resid);
 #ifdef USE_NSIGHT
         nvtxRangePop();
+        nvtxRangePushA("allreduce");
 #endif
-
-        for (std::size_t i = 0; i < unconverged; ++i)
-        {
-            //    resid[i] = std::sqrt(resid_h[i]);
-            resid[i] = std::sqrt(matrices_->Resid().ptr()[i + locked]);
-        }
+        this->gatherResids(resid, locked, block);
     }
 
     void syherk(char uplo, char trans, std::size_t n, std::size_t k, T* alpha,
@@ -1104,9 +1210,10 @@ public:
         nvtxRangePop();
         nvtxRangePushA("ChaseMpiDLA: hhQR");
 #endif
-        auto nevex = nev_ + nex_;
-        std::unique_ptr<T[]> tau(new T[nevex]);
 #if defined(HAS_SCALAPACK)
+        auto nevex = nev_ + nex_;
+        T* tau =
+            matrices_->workspace().template get<T>(WorkspaceSlot::Tau, nevex);
         int one = 1;
 #ifdef USE_NSIGHT
         nvtxRangePushA("pgeqrf+pgqr");
@@ -1119,9 +1226,9 @@ public:
             matrices_->C().sync2Ptr();
         }
         t_pgeqrf(N_, nevex, matrices_->C().ptr(), one, one, desc1D_Nxnevx_,
-                 tau.get());
+                 tau);
         t_pgqr(N_, nevex, nevex, matrices_->C().ptr(), one, one, desc1D_Nxnevx_,
-               tau.get());
+               tau);
 #if defined(HAS_UM)
         matrices_->C().syncFromPtr();
 #endif
@@ -1138,12 +1245,44 @@ public:
         nvtxRangePop();
 #endif
 #else
-        int grank;
-        MPI_Comm_rank(MPI_COMM_WORLD, &grank);
-        if (grank == 0)
-            std::cout << "ScaLAPACK is not available, use LAPACK Householder "
-                         "QR instead"
-                      << std::endl;
+        this->tsQR(locked);
+#endif
+#ifdef USE_NSIGHT
+        nvtxRangePop();
+#endif
+    }
+
+    /*! Implementation of a communication-avoiding Householder QR (TSQR) of
+     `C` within each column communicator, which needs neither ScaLAPACK nor
+     the redundant gathering of `C`.
+     * - The workflow of TSQR is
+     *     - `geqrf`: the local rows of `C` are factorized into `Q0 * R0`
+     *     - the `R` factors are reduced along a binary tree over the column
+     communicator: at each level, a rank receives the `R` of its partner and
+     factorizes the stacked `[R; R_partner]` into `Ql * R`
+     *     - the orthonormal factor is then built down the tree: a rank
+     multiplies the `Ql` of a level with the block of the final `Q` it got
+     from its parent, keeps the top half and sends the bottom half to its
+     partner
+     *     - `gemm`: the local rows of the final `Q` are `Q0` times the block
+     of the leaf
+       - The memory and the communication per rank are
+     `O(m * (nev+nex) + (nev+nex)^2 * log(p))`, with `p` the size of the
+     column communicator, and it is as stable as Householder QR.
+       - The factorization runs on the CPU, `C` is synchronized from and to
+     the GPU if needed.
+       - With `locked > 0` and `C` on the CPU, only the `nev+nex-locked`
+     active columns are factorized, after their projection against the
+     locked ones (see projectLocked()). The projection and the TSQR are done
+     twice, as the first TSQR amplifies the components along the locked
+     columns left by the projection with the condition number of the active
+     block.
+     */
+    void tsQR(std::size_t locked) override
+    {
+#ifdef USE_NSIGHT
+        nvtxRangePushA("ChaseMpiDLA: tsQR");
+#endif
 #if defined(HAS_UM)
         matrices_->C().sync2Ptr();
 #endif
@@ -1152,28 +1291,121 @@ public:
             matrices_->C().sync2Ptr();
         }
 
-        if (!alloc_)
+        std::size_t off = lockedOffset(locked);
+        for (int pass = 0; pass < (off > 0 ? 2 : 1); pass++)
         {
-            V___ = std::make_unique<Matrix<T>>(
-                matrices_->get_Mode() == 3 ? 3 : 0, N_, nevex);
-            alloc_ = true;
+            this->projectLocked(off);
+            this->tsqrColumns(matrices_->C().ptr() + off * m_,
+                              nev_ + nex_ - off);
         }
 
-        this->collecRedundantVecs(matrices_->C().ptr(), V___.get()->ptr(), 0,
-                                  nevex);
-        t_geqrf(LAPACK_COL_MAJOR, N_, nevex, V___.get()->ptr(), N_, tau.get());
-        t_gqr(LAPACK_COL_MAJOR, N_, nevex, nevex, V___.get()->ptr(), N_,
-              tau.get());
-        this->preApplication(V___.get()->ptr(), 0, nevex);
+#if defined(HAS_UM)
+        matrices_->C().syncFromPtr();
+#endif
+        if (C != matrices_->C().ptr())
+        {
+            matrices_->C().syncFromPtr();
+        }
 
         isHHqr = true;
-
-#endif
 #ifdef USE_NSIGHT
         nvtxRangePop();
 #endif
     }
 
+    //! TSQR of the `n` columns of the local rows `V` of `C`, which are
+    //! overwritten by the orthonormal factor, see tsQR().
+    void tsqrColumns(T* V, std::size_t n)
+    {
+        std::size_t k = std::min(m_, n);
+        T one = T(1.0);
+        T zero = T(0.0);
+
+        int levels = 0;
+        while ((1 << levels) < col_size_)
+        {
+            levels++;
+        }
+
+        Workspace& ws = matrices_->workspace();
+        T* tau = ws.template get<T>(WorkspaceSlot::Tau, n);
+        T* W = ws.template get<T>(WorkspaceSlot::TsqrLocal, m_ * n);
+        T* Q = ws.template get<T>(WorkspaceSlot::TsqrTree,
+                                  std::max(levels, 1) * 2 * n * n);
+        // the stacked R factors (2n x n), followed by three n x n blocks
+        T* S = ws.template get<T>(WorkspaceSlot::TsqrStack, 5 * n * n);
+        T* R = S + 2 * n * n;
+        T* Qin = R + n * n;
+        T* buf = Qin + n * n;
+        int count = static_cast<int>(n * n);
+
+        // local QR, R0 is kept in the top half of S
+        t_lacpy('A', m_, n, V, m_, W, m_);
+        t_geqrf(LAPACK_COL_MAJOR, m_, n, W, m_, tau);
+        std::fill_n(S, 2 * n * n, zero);
+        t_lacpy('U', k, n, W, m_, S, 2 * n);
+        t_gqr(LAPACK_COL_MAJOR, m_, k, k, W, m_, tau);
+
+        // reduction of the R factors up the tree
+        int sent = levels;
+        for (int l = 0; l < levels; l++)
+        {
+            int step = 1 << l;
+            if (col_rank_ % (2 * step) == step)
+            {
+                t_lacpy('A', n, n, S, 2 * n, R, n);
+                MPI_Send(R, count, getMPI_Type<T>(), col_rank_ - step, l,
+                         col_comm_);
+                sent = l;
+                break;
+            }
+            if (col_rank_ + step < col_size_)
+            {
+                MPI_Recv(R, count, getMPI_Type<T>(), col_rank_ + step, l,
+                         col_comm_, MPI_STATUS_IGNORE);
+                T* Ql = Q + l * 2 * n * n;
+                t_lacpy('A', n, n, R, n, S + n, 2 * n);
+                t_geqrf(LAPACK_COL_MAJOR, 2 * n, n, S, 2 * n, tau);
+                t_lacpy('A', 2 * n, n, S, 2 * n, Ql, 2 * n);
+                std::fill_n(S, 2 * n * n, zero);
+                t_lacpy('U', n, n, Ql, 2 * n, S, 2 * n);
+                t_gqr(LAPACK_COL_MAJOR, 2 * n, n, n, Ql, 2 * n, tau);
+            }
+        }
+
+        // construction of Q down the tree
+        if (sent == levels)
+        {
+            std::fill_n(Qin, n * n, zero);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                Qin[i + i * n] = one;
+            }
+        }
+        else
+        {
+            MPI_Recv(Qin, count, getMPI_Type<T>(), col_rank_ - (1 << sent),
+                     levels + sent, col_comm_, MPI_STATUS_IGNORE);
+        }
+        for (int l = sent - 1; l >= 0; l--)
+        {
+            int step = 1 << l;
+            if (col_rank_ + step < col_size_)
+            {
+                t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 2 * n, n, n,
+                       &one, Q + l * 2 * n * n, 2 * n, Qin, n, &zero, S,
+                       2 * n);
+                t_lacpy('A', n, n, S + n, 2 * n, buf, n);
+                MPI_Send(buf, count, getMPI_Type<T>(), col_rank_ + step,
+                         levels + l, col_comm_);
+                t_lacpy('A', n, n, S, 2 * n, Qin, n);
+            }
+        }
+
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m_, n, k, &one, W,
+               m_, Qin, n, &zero, V, m_);
+    }
+
     /*! Implementation of partially 1D distributed Cholesky QR within each
      column communicator.
      * - The workflow of a 1D Cholesky QR is
@@ -1197,6 +1429,11 @@ public:
      distributed-memory ChASE, and it is implemented in
      ChaseMpiDLAMultiGPU::syherk, ChaseMpiDLAMultiGPU::potrf and
             ChaseMpiDLAMultiGPU::trsm, respectively
+       - With `locked > 0`, only the `nev+nex-locked` active columns are
+     factorized: before each `sy(he)rk`, they are projected against the
+     locked columns (see projectLocked()), such that the cost of the QR
+     shrinks with the number of converged eigenpairs. This is restricted to
+     the CPU, the full `nev+nex` columns are factorized otherwise.
    */
 
     int cholQR1(std::size_t locked) override
@@ -1206,17 +1443,18 @@ public:
         int grank;
         MPI_Comm_rank(MPI_COMM_WORLD, &grank);
 
-        auto nevex = nev_ + nex_;
+        std::size_t off = lockedOffset(locked);
+        std::size_t n = nev_ + nex_ - off;
+        T* V = C + off * m_;
         bool first_iter = !cuda_aware_;
         T one = T(1.0);
         T zero = T(0.0);
         int info = 1;
 
-        dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex,
-                     first_iter);
-        AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                  MPI_SUM, col_comm_, mpi_wrapper_);
-        info = dla_->potrf('U', nevex, A, nevex, true);
+        this->projectLocked(off);
+        dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, first_iter);
+        this->allreduceHermitian('U', n, n, col_comm_);
+        info = dla_->potrf('U', n, A, n, true);
 
         if (info != 0)
         {
@@ -1224,8 +1462,7 @@ public:
         }
         else
         {
-            dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_,
-                       false);
+            dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, false);
 #ifdef CHASE_OUTPUT
             if (grank == 0)
             {
@@ -1244,18 +1481,19 @@ public:
         int grank;
         MPI_Comm_rank(MPI_COMM_WORLD, &grank);
 
-        auto nevex = nev_ + nex_;
+        std::size_t off = lockedOffset(locked);
+        std::size_t n = nev_ + nex_ - off;
+        T* V = C + off * m_;
         bool first_iter = !cuda_aware_;
         T one = T(1.0);
         T zero = T(0.0);
         int info = 1;
 
-        dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex,
-                     first_iter);
+        this->projectLocked(off);
+        dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, first_iter);
 
-        AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                  MPI_SUM, col_comm_, mpi_wrapper_);
-        info = dla_->potrf('U', nevex, A, nevex, true);
+        this->allreduceHermitian('U', n, n, col_comm_);
+        info = dla_->potrf('U', n, A, n, true);
 
         if (info != 0)
         {
@@ -1263,19 +1501,16 @@ public:
         }
         else
         {
-            dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_,
-                       true);
+            dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, true);
 
-            dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex,
-                         false);
+            this->projectLocked(off);
+            dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, false);
 
-            AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                      MPI_SUM, col_comm_, mpi_wrapper_);
+            this->allreduceHermitian('U', n, n, col_comm_);
 
-            info = dla_->potrf('U', nevex, A, nevex, false);
+            info = dla_->potrf('U', n, A, n, false);
 
-            dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_,
-                       false);
+            dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, false);
 #ifdef CHASE_OUTPUT
             if (grank == 0)
             {
@@ -1295,20 +1530,21 @@ public:
         MPI_Comm_rank(MPI_COMM_WORLD, &grank);
 
         Base<T> shift;
-        auto nevex = nev_ + nex_;
+        std::size_t off = lockedOffset(locked);
+        std::size_t n = nev_ + nex_ - off;
+        T* V = C + off * m_;
         bool first_iter = !cuda_aware_;
         T one = T(1.0);
         T zero = T(0.0);
         int info = 1;
 
-        dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex,
-                     first_iter);
+        this->projectLocked(off);
+        dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, first_iter);
 
-        AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                  MPI_SUM, col_comm_, mpi_wrapper_);
+        this->allreduceHermitian('U', n, n, col_comm_);
 
         Base<T> nrmf = 0.0;
-        dla_->computeDiagonalAbsSum(A, &nrmf, nevex, nevex);
+        dla_->computeDiagonalAbsSum(A, &nrmf, n, n);
         // Base<T> nrmf = dla_->nrm2(m_ * nevex, C, 1);
         // nrmf = std::pow(nrmf, 2);
         // MPI_Allreduce(MPI_IN_PLACE, &nrmf, 1, getMPI_Type<Base<T>>(),
@@ -1316,39 +1552,39 @@ public:
 
         shift = std::sqrt(N_) * nrmf * std::numeric_limits<Base<T>>::epsilon();
 
-        dla_->shiftMatrixForQR(A, nevex, (T)shift);
+        dla_->shiftMatrixForQR(A, n, (T)shift);
 
-        info = dla_->potrf('U', nevex, A, nevex, true);
+        info = dla_->potrf('U', n, A, n, true);
 
         if (info != 0)
         {
             return info;
         }
 
-        dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_, true);
+        dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, true);
 
-        dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex, false);
+        this->projectLocked(off);
+        dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, false);
 
-        AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                  MPI_SUM, col_comm_, mpi_wrapper_);
+        this->allreduceHermitian('U', n, n, col_comm_);
 
         // check info after this step
-        info = dla_->potrf('U', nevex, A, nevex, true);
+        info = dla_->potrf('U', n, A, n, true);
         if (info != 0)
         {
             return info;
         }
 
-        dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_, true);
+        dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, true);
 
-        dla_->syherk('U', 'C', nevex, m_, &one, C, m_, &zero, A, nevex, false);
+        this->projectLocked(off);
+        dla_->syherk('U', 'C', n, m_, &one, V, m_, &zero, A, n, false);
 
-        AllReduce(allreduce_backend, A, nevex * nevex, getMPI_Type<T>(),
-                  MPI_SUM, col_comm_, mpi_wrapper_);
+        this->allreduceHermitian('U', n, n, col_comm_);
 
-        dla_->potrf('U', nevex, A, nevex, false);
+        dla_->potrf('U', n, A, n, false);
 
-        dla_->trsm('R', 'U', 'N', 'N', m_, nevex, &one, A, nevex, C, m_, false);
+        dla_->trsm('R', 'U', 'N', 'N', m_, n, &one, A, n, V, m_, false);
 
 #ifdef CHASE_OUTPUT
         if (grank == 0)
@@ -1367,7 +1603,11 @@ public:
         MPI_Comm_rank(MPI_COMM_WORLD, &grank);
         auto nevex = nev_ + nex_;
 
-        std::vector<T> V2(N_ * (nev_ + nex_));
+        Workspace& ws = matrices_->workspace();
+        T* V2 = matrices_
+                    ->scratch(WorkspaceSlot::Redundant,
+                              matrices_->get_Mode() == 3 ? 3 : 0, N_, nevex)
+                    ->ptr();
 #if defined(HAS_UM)
         matrices_->C().sync2Ptr();
 #else
@@ -1377,20 +1617,21 @@ public:
         }
 #endif
 
-        this->collecRedundantVecs(matrices_->C().ptr(), V2.data(), 0,
-                                  nev_ + nex_);
-        std::vector<Base<T>> S(nev_ + nex_ - locked);
+        this->collecRedundantVecs(matrices_->C().ptr(), V2, 0, nev_ + nex_);
+        Base<T>* S =
+            ws.template get<Base<T>>(WorkspaceSlot::Singular, nevex - locked);
         T* U;
         std::size_t ld = 1;
         T* Vt;
-        t_gesvd('N', 'N', N_, nev_ + nex_ - locked, V2.data() + N_ * locked, N_,
-                S.data(), U, ld, Vt, ld);
-        std::vector<Base<T>> norms(nev_ + nex_ - locked);
+        t_gesvd('N', 'N', N_, nev_ + nex_ - locked, V2 + N_ * locked, N_, S, U,
+                ld, Vt, ld);
+        Base<T>* norms =
+            ws.template get<Base<T>>(WorkspaceSlot::Norms, nevex - locked);
         for (auto i = 0; i < nev_ + nex_ - locked; i++)
         {
             norms[i] = std::sqrt(t_sqrt_norm(S[i]));
         }
-        std::sort(norms.begin(), norms.end());
+        std::sort(norms, norms + nevex - locked);
         if (grank == 0)
         {
             std::cout << "estimate: " << cond << ", rcond: "
@@ -1417,15 +1658,38 @@ public:
         }
     }
 
+    /*!
+      - For ChaseMpiDLA, `Swap` exchanges the local rows of the columns `i`
+      and `j` of both `C_` and `C2_`, as Permute() does.
+      - For the meaning of this function, please visit ChaseMpiDLAInterface.
+    */
     void Swap(std::size_t i, std::size_t j) override
     {
-        Memcpy(memcpy_mode[0], vv, C + m_ * i, m_ * sizeof(T));
-        Memcpy(memcpy_mode[0], C + m_ * i, C + m_ * j, m_ * sizeof(T));
-        Memcpy(memcpy_mode[0], C + m_ * j, vv, m_ * sizeof(T));
+        for (T* V : {C, C2})
+        {
+            Memcpy(memcpy_mode[0], vv, V + m_ * i, m_ * sizeof(T));
+            Memcpy(memcpy_mode[0], V + m_ * i, V + m_ * j, m_ * sizeof(T));
+            Memcpy(memcpy_mode[0], V + m_ * j, vv, m_ * sizeof(T));
+        }
+    }
 
-        Memcpy(memcpy_mode[0], vv, C + m_ * i, m_ * sizeof(T));
-        Memcpy(memcpy_mode[0], C + m_ * i, C + m_ * j, m_ * sizeof(T));
-        Memcpy(memcpy_mode[0], C + m_ * j, vv, m_ * sizeof(T));
+    /*!
+      - For ChaseMpiDLA, `Permute` reorders the local rows of both `C_` and
+      `C2_`, which hold the same vectors outside of the filter, with `vv_`
+      as scratch column. No communication is required.
+      - For the meaning of this function, please visit ChaseMpiDLAInterface.
+    */
+    void Permute(const std::vector<std::size_t>& perm) override
+    {
+        for (T* V : {C, C2})
+        {
+            auto col = [&](std::size_t k) {
+                return k == perm.size() ? vv : V + m_ * k;
+            };
+            permute_columns(perm, [&](std::size_t dst, std::size_t src) {
+                Memcpy(memcpy_mode[0], col(dst), col(src), m_ * sizeof(T));
+            });
+        }
     }
 
     void LanczosDos(std::size_t idx, std::size_t m, T* ritzVc) override
@@ -1452,10 +1716,14 @@ public:
         {
             matrix_mode = 1;
         }
-        v_0 = new Matrix<T>(matrix_mode, m_, numvec);
-        v_1 = new Matrix<T>(matrix_mode, m_, numvec);
-        v_2 = new Matrix<T>(matrix_mode, m_, numvec);
-        v_w = new Matrix<T>(matrix_mode, n_, numvec);
+        v_0 = matrices_->scratch(WorkspaceSlot::LanczosV0, matrix_mode, m_,
+                                 numvec);
+        v_1 = matrices_->scratch(WorkspaceSlot::LanczosV1, matrix_mode, m_,
+                                 numvec);
+        v_2 = matrices_->scratch(WorkspaceSlot::LanczosV2, matrix_mode, m_,
+                                 numvec);
+        v_w = matrices_->scratch(WorkspaceSlot::LanczosW, matrix_mode, n_,
+                                 numvec);
 
         // Memcpy(memcpy_mode[1], v_1->ptr(), C, m_ * numvec * sizeof(T));
         Memcpy(memcpy_mode[1], v_1->ptr(), C, m_ * numvec * sizeof(T));
@@ -1467,8 +1735,11 @@ public:
             real_alpha[i] = std::pow(real_alpha[i], 2);
         }
 
-        MPI_Allreduce(MPI_IN_PLACE, real_alpha.data(), numvec,
-                      getMPI_Type<Base<T>>(), MPI_SUM, col_comm_);
+        {
+            ChaseCommStats::Scope comm_stats(numvec * sizeof(Base<T>));
+            MPI_Allreduce(MPI_IN_PLACE, real_alpha.data(), numvec,
+                          getMPI_Type<Base<T>>(), MPI_SUM, col_comm_);
+        }
 
         for (auto i = 0; i < numvec; i++)
         {
@@ -1491,8 +1762,11 @@ public:
 
             // dla_->applyVec(v_1->ptr(), v_w->ptr(), numvec);
             dla_->applyVec(v_1, v_w, numvec);
-            MPI_Allreduce(MPI_IN_PLACE, v_w->ptr(), n_ * numvec,
-                          getMPI_Type<T>(), MPI_SUM, col_comm_);
+            {
+                ChaseCommStats::Scope comm_stats(n_ * numvec * sizeof(T));
+                MPI_Allreduce(MPI_IN_PLACE, v_w->ptr(), n_ * numvec,
+                              getMPI_Type<T>(), MPI_SUM, col_comm_);
+            }
             // AllReduce(allreduce_backend, v_w->ptr(), n_ * numvec,
             //           getMPI_Type<T>(), MPI_SUM, col_comm_, mpi_wrapper_);
             // this->B2C(v_w->ptr(), 0, v_2->ptr(), 0, numvec);
@@ -1504,8 +1778,11 @@ public:
                 alpha[i] = -alpha[i];
             }
 
-            MPI_Allreduce(MPI_IN_PLACE, alpha.data(), numvec, getMPI_Type<T>(),
-                          MPI_SUM, col_comm_);
+            {
+                ChaseCommStats::Scope comm_stats(numvec * sizeof(T));
+                MPI_Allreduce(MPI_IN_PLACE, alpha.data(), numvec,
+                              getMPI_Type<T>(), MPI_SUM, col_comm_);
+            }
 
             dla_->axpy_batch(m_, alpha.data(), v_1, 1, v_2, 1, numvec);
             for (auto i = 0; i < numvec; i++)
@@ -1539,8 +1816,11 @@ public:
                 r_beta[i] = std::pow(r_beta[i], 2);
             }
 
-            MPI_Allreduce(MPI_IN_PLACE, r_beta, numvec, getMPI_Type<Base<T>>(),
-                          MPI_SUM, col_comm_);
+            {
+                ChaseCommStats::Scope comm_stats(numvec * sizeof(Base<T>));
+                MPI_Allreduce(MPI_IN_PLACE, r_beta, numvec,
+                              getMPI_Type<Base<T>>(), MPI_SUM, col_comm_);
+            }
 
             for (auto i = 0; i < numvec; i++)
             {
@@ -1570,28 +1850,33 @@ public:
     void B2C(T* B, std::size_t off1, T* C, std::size_t off2,
              std::size_t block) override
     {
-        for (auto i = 0; i < b_lens.size(); i++)
         {
-            if (col_rank_ == b_dests[i])
+            ChaseCommStats::Scope comm_stats;
+            for (auto i = 0; i < b_lens.size(); i++)
             {
-                if (row_rank_ == b_srcs[i])
-                {
-                    MPI_Ibcast(B + off1 * n_, block, b_sends_[i], b_srcs[i],
-                               row_comm_, &reqsb2c_[i]);
-                }
-                else
+                if (col_rank_ == b_dests[i])
                 {
-                    MPI_Ibcast(C + off1 * m_, block, c_recvs_[i], b_srcs[i],
-                               row_comm_, &reqsb2c_[i]);
+                    if (row_rank_ == b_srcs[i])
+                    {
+                        comm_stats.count(typeBytes(b_sends_[i], block));
+                        MPI_Ibcast(B + off1 * n_, block, b_sends_[i],
+                                   b_srcs[i], row_comm_, &reqsb2c_[i]);
+                    }
+                    else
+                    {
+                        comm_stats.count(typeBytes(c_recvs_[i], block));
+                        MPI_Ibcast(C + off1 * m_, block, c_recvs_[i],
+                                   b_srcs[i], row_comm_, &reqsb2c_[i]);
+                    }
                 }
             }
-        }
 
-        for (auto i = 0; i < b_lens.size(); i++)
-        {
-            if (col_rank_ == b_dests[i])
+            for (auto i = 0; i < b_lens.size(); i++)
             {
-                MPI_Wait(&reqsb2c_[i], MPI_STATUSES_IGNORE);
+                if (col_rank_ == b_dests[i])
+                {
+                    MPI_Wait(&reqsb2c_[i], MPI_STATUSES_IGNORE);
+                }
             }
         }
 
@@ -1599,8 +1884,8 @@ public:
         {
             if (col_rank_ == b_dests[i] && row_rank_ == b_srcs[i])
             {
-                t_lacpy('A', b_lens[i], block, B + off1 * n_ + b_disps_2[i], n_,
-                        C + off1 * m_ + c_disps_2[i], m_);
+                t_lacpy_par(b_lens[i], block, B + off1 * n_ + b_disps_2[i], n_,
+                            C + off1 * m_ + c_disps_2[i], m_);
             }
         }
     }
@@ -1627,13 +1912,10 @@ public:
                 }
             }
 
-            for (auto i = 0; i < row_size_; i++)
+            if (row_rank_ == col_rank_)
             {
-                if (row_rank_ == col_rank_)
-                {
-                    dla_->lacpy('A', n_, block, B->ptr() + off1 * n_, n_,
-                                C->ptr() + off1 * m_, m_);
-                }
+                dla_->lacpy('A', n_, block, B->ptr() + off1 * n_, n_,
+                            C->ptr() + off1 * m_, m_);
             }
         }
         else
@@ -1663,28 +1945,33 @@ public:
 
     void C2B(T* C, std::size_t off1, T* B, std::size_t off2, std::size_t block)
     {
-        for (auto i = 0; i < c_lens.size(); i++)
         {
-            if (row_rank_ == c_dests[i])
+            ChaseCommStats::Scope comm_stats;
+            for (auto i = 0; i < c_lens.size(); i++)
             {
-                if (col_rank_ == c_srcs[i])
-                {
-                    MPI_Ibcast(C + off1 * m_, block, c_sends_[i], c_srcs[i],
-                               col_comm_, &reqsc2b_[i]);
-                }
-                else
+                if (row_rank_ == c_dests[i])
                 {
-                    MPI_Ibcast(B + off1 * n_, block, b_recvs_[i], c_srcs[i],
-                               col_comm_, &reqsc2b_[i]);
+                    if (col_rank_ == c_srcs[i])
+                    {
+                        comm_stats.count(typeBytes(c_sends_[i], block));
+                        MPI_Ibcast(C + off1 * m_, block, c_sends_[i],
+                                   c_srcs[i], col_comm_, &reqsc2b_[i]);
+                    }
+                    else
+                    {
+                        comm_stats.count(typeBytes(b_recvs_[i], block));
+                        MPI_Ibcast(B + off1 * n_, block, b_recvs_[i],
+                                   c_srcs[i], col_comm_, &reqsc2b_[i]);
+                    }
                 }
             }
-        }
 
-        for (auto i = 0; i < c_lens.size(); i++)
-        {
-            if (row_rank_ == c_dests[i])
+            for (auto i = 0; i < c_lens.size(); i++)
             {
-                MPI_Wait(&reqsc2b_[i], MPI_STATUSES_IGNORE);
+                if (row_rank_ == c_dests[i])
+                {
+                    MPI_Wait(&reqsc2b_[i], MPI_STATUSES_IGNORE);
+                }
             }
         }
 
@@ -1692,8 +1979,8 @@ public:
         {
             if (row_rank_ == c_dests[i] && col_rank_ == c_srcs[i])
             {
-                t_lacpy('A', c_lens[i], block, C + off1 * m_ + c_disps_2[i], m_,
-                        B + off1 * n_ + b_disps_2[i], n_);
+                t_lacpy_par(c_lens[i], block, C + off1 * m_ + c_disps_2[i], m_,
+                            B + off1 * n_ + b_disps_2[i], n_);
             }
         }
     }
@@ -1729,6 +2016,174 @@ public:
     }
 
 private:
+    //! Returns the number of leading columns of `C` which the CholeskyQRs
+    //! skip: the `locked` converged vectors, which are already orthonormal,
+    //! or `0` if the local backend works on the GPU, whose CholeskyQR
+    //! kernels always factorize all the `nev+nex` columns.
+    std::size_t lockedOffset(std::size_t locked)
+    {
+        return matrices_->get_Mode() == 0 ? locked : 0;
+    }
+
+    //! Allreduces the `uplo` triangle of the Hermitian `n x n` matrix `A`
+    //! with leading dimension `lda` within `comm`. On the host, only the
+    //! packed triangle is reduced, see AllReduceTriangle(). Device buffers
+    //! are reduced as a whole.
+    void allreduceHermitian(char uplo, std::size_t n, std::size_t lda,
+                            MPI_Comm comm)
+    {
+        if (cuda_aware_)
+        {
+            AllReduce(allreduce_backend, A, lda * n, getMPI_Type<T>(), MPI_SUM,
+                      comm, mpi_wrapper_);
+            return;
+        }
+        T* buf = matrices_->workspace().template get<T>(
+            WorkspaceSlot::Packed, n * (n + 1) / 2);
+        AllReduceTriangle(allreduce_backend, uplo, n, A, lda, buf,
+                          getMPI_Type<T>(), MPI_SUM, comm, mpi_wrapper_);
+    }
+
+    //! Block classical Gram-Schmidt of the active columns of `C` against its
+    //! first `locked` columns: `C2 -= C1 * (C1^H * C2)`, with a single
+    //! allreduce of the `locked x (nev+nex-locked)` coefficients within the
+    //! column communicator. It does nothing if `locked == 0`.
+    void projectLocked(std::size_t locked)
+    {
+        if (locked == 0)
+        {
+            return;
+        }
+        std::size_t n = nev_ + nex_ - locked;
+        T one = T(1.0);
+        T zero = T(0.0);
+        T minus_one = T(-1.0);
+        T* P = matrices_->workspace().template get<T>(WorkspaceSlot::Block,
+                                                      locked * n);
+
+        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, locked, n, m_,
+               &one, C, m_, C + locked * m_, m_, &zero, P, locked);
+        AllReduce(allreduce_backend, P, locked * n, getMPI_Type<T>(), MPI_SUM,
+                  col_comm_, mpi_wrapper_);
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m_, n, locked,
+               &minus_one, C, m_, P, locked, &one, C + locked * m_, m_);
+    }
+
+    //! Bytes of `count` elements of the MPI datatype `type`.
+    static std::size_t typeBytes(MPI_Datatype type, std::size_t count)
+    {
+        int size;
+        MPI_Type_size(type, &size);
+        return static_cast<std::size_t>(size) * count;
+    }
+
+    //! Starts the in-place reduction of a chunk for applyChunk(), the request
+    //! is appended to `pending_reqs_`.
+    template <typename U>
+    void allreduceChunk(U* buf, std::size_t count, MPI_Comm comm)
+    {
+        if (allreduce_backend != MPI_BACKEND)
+        {
+            AllReduce(allreduce_backend, buf, count, getMPI_Type<U>(), MPI_SUM,
+                      comm, mpi_wrapper_);
+            return;
+        }
+        ChaseCommStats::Scope comm_stats(count * sizeof(U));
+        pending_reqs_.push_back(MPI_REQUEST_NULL);
+        MPI_Iallreduce(MPI_IN_PLACE, buf, count, getMPI_Type<U>(), MPI_SUM,
+                       comm, &pending_reqs_.back());
+        // give the MPI library a chance to progress the previous chunks
+        int flag;
+        MPI_Testall(pending_reqs_.size(), pending_reqs_.data(), &flag,
+                    MPI_STATUSES_IGNORE);
+    }
+
+    //! Fills the local rows of the `ncols` vectors `V`, in the layout of `C`,
+    //! with the columns `[col_off, col_off + ncols)` of the random matrix of
+    //! ChaseRandom, indexed by global row such that they do not depend on the
+    //! grid.
+    void fillRandom(std::size_t ncols, T* V, std::size_t ldv,
+                    std::size_t col_off)
+    {
+        ChaseRandom rnd(1337);
+        for (std::size_t i = 0; i < mblocks_; i++)
+        {
+            rnd.fill(r_lens_[i], ncols, V + r_offs_l_[i], ldv, r_offs_[i],
+                     col_off);
+        }
+    }
+
+    //! Checks the Symmetric/Hermitian property of `H` for local backends
+    //! which do not store it as a dense block in ChaseMpiMatrices.
+    /*! Only the local product `H^H * x` provided by `dla_->applyVec()` is
+        required: for two random vectors `x` and `y`, `(H^H y)^H x` and
+        `conj((H^H x)^H y)` must agree up to rounding errors.
+    */
+    bool checkSymmetryBilinear()
+    {
+        std::vector<T> x(m_), y(m_);
+        std::vector<T> xB(n_), yB(n_), Hx(n_), Hy(n_);
+
+        this->fillRandom(1, x.data(), m_, 0);
+        this->fillRandom(1, y.data(), m_, 1);
+
+        dla_->applyVec(x.data(), Hx.data(), 1);
+        dla_->applyVec(y.data(), Hy.data(), 1);
+        MPI_Allreduce(MPI_IN_PLACE, Hx.data(), n_, getMPI_Type<T>(), MPI_SUM,
+                      col_comm_);
+        MPI_Allreduce(MPI_IN_PLACE, Hy.data(), n_, getMPI_Type<T>(), MPI_SUM,
+                      col_comm_);
+
+        this->C2B(x.data(), 0, xB.data(), 0, 1);
+        this->C2B(y.data(), 0, yB.data(), 0, 1);
+
+        // yHx, xHy and the squared norms of x, y, Hx, Hy
+        std::vector<T> prods(6);
+        prods[0] = t_dot(n_, Hy.data(), 1, xB.data(), 1);
+        prods[1] = t_dot(n_, Hx.data(), 1, yB.data(), 1);
+        prods[2] = t_dot(n_, xB.data(), 1, xB.data(), 1);
+        prods[3] = t_dot(n_, yB.data(), 1, yB.data(), 1);
+        prods[4] = t_dot(n_, Hx.data(), 1, Hx.data(), 1);
+        prods[5] = t_dot(n_, Hy.data(), 1, Hy.data(), 1);
+        MPI_Allreduce(MPI_IN_PLACE, prods.data(), 6, getMPI_Type<T>(), MPI_SUM,
+                      row_comm_);
+
+        Base<T> tol = 10 * N_ * std::numeric_limits<Base<T>>::epsilon() *
+                      (std::sqrt(std::real(prods[3]) * std::real(prods[4])) +
+                       std::sqrt(std::real(prods[2]) * std::real(prods[5])));
+
+        return std::abs(prods[0] - conjugate(prods[1])) <= tol;
+    }
+
+    //! Sums up the local parts of the squared residuals within the row
+    //! communicator and returns their square roots in `resid`.
+    void gatherResids(Base<T>* resid, std::size_t locked,
+                      std::size_t unconverged)
+    {
+        AllReduce(allreduce_backend, rsd + locked, unconverged,
+                  getMPI_Type<Base<T>>(), MPI_SUM, row_comm_, mpi_wrapper_);
+//  Base<T> *resid_h;
+// dla_->retrieveResid(&resid_h, locked, unconverged);
+#if defined(HAS_UM)
+        matrices_->Resid().sync2Ptr(1, unconverged, locked);
+#else
+        if (rsd != matrices_->Resid().ptr())
+        {
+            //	std::cout << "rsd != Resid().ptr()" << std::endl;
+            matrices_->Resid().sync2Ptr(1, unconverged, locked);
+        }
+#endif
+#ifdef USE_NSIGHT
+        nvtxRangePop();
+#endif
+
+        for (std::size_t i = 0; i < unconverged; ++i)
+        {
+            //    resid[i] = std::sqrt(resid_h[i]);
+            resid[i] = std::sqrt(matrices_->Resid().ptr()[i + locked]);
+        }
+    }
+
     enum NextOp
     {
         cAb,
@@ -1787,6 +2242,10 @@ private:
                       //!< has the same distribution scheme
     bool istartOfFilter_; //!< a flag indicating if it is the starting pointer
                           //!< of apply Chebyshev filter
+    bool single_ = false; //!< a flag indicating if apply() runs in single
+                          //!< precision
+    std::vector<MPI_Request> pending_reqs_; //!< the reductions of the chunks
+                                            //!< of the current step
     std::vector<MPI_Request> reqsc2b_; //!< a collection of MPI requests for
                                        //!< asynchonous communication
     std::vector<MPI_Datatype>
@@ -1850,11 +2309,6 @@ private:
 
     // buff
     std::unique_ptr<Matrix<T>> buff__;
-
-#if !defined(HAS_SCALAPACK)
-    std::unique_ptr<Matrix<T>> V___;
-    bool alloc_ = false;
-#endif
 };
 } // namespace mpi
 } // namespace chase
@@ -7,6 +7,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "ChASE-MPI/blas_templates.hpp"
 #include "ChASE-MPI/chase_mpi_properties.hpp"
 #include "ChASE-MPI/chase_mpidla_interface.hpp"
@@ -67,6 +72,21 @@ public:
         MPI_Comm_rank(col_comm, &mpi_col_rank);
 
         vv_ = matrices_.vv().ptr();
+
+        for (std::size_t j = 0; j < nblocks_; j++)
+        {
+            for (std::size_t i = 0; i < mblocks_; i++)
+            {
+                std::size_t lo = std::max(r_offs_[i], c_offs_[j]);
+                std::size_t hi = std::min(r_offs_[i] + r_lens_[i],
+                                          c_offs_[j] + c_lens_[j]);
+                for (std::size_t g = lo; g < hi; g++)
+                {
+                    diag_.emplace_back(g - r_offs_[i] + r_offs_l_[i],
+                                       g - c_offs_[j] + c_offs_l_[j]);
+                }
+            }
+        }
     }
 
     ~ChaseMpiDLABlaslapack() {}
@@ -77,20 +97,17 @@ public:
         t_lacpy('A', m_, nev_ + nex_, C_, m_, C2_, m_);
         next_ = NextOp::bAc;
     }
-    //! This function generates the random values for each MPI proc using C++
-    //! STL
-    //!     - each MPI proc with a same MPI rank among different column
-    //!     communicator
-    //!       same a same seed of RNG
+    //! This function generates the random values of the local rows of each
+    //! MPI proc with the counter-based ChaseRandom, keyed by the global row
+    //! and column indices, such that the random vectors do not depend on
+    //! the MPI grid.
     void initRndVecs() override
     {
-        std::mt19937 gen(1337.0 + mpi_col_rank);
-        std::normal_distribution<> d;
-
-        for (auto j = 0; j < m_ * (nev_ + nex_); j++)
+        ChaseRandom rnd(1337);
+        for (std::size_t i = 0; i < mblocks_; i++)
         {
-            auto rnd = getRandomT<T>([&]() { return d(gen); });
-            C_[j] = rnd;
+            rnd.fill(r_lens_[i], nev_ + nex_, C_ + r_offs_l_[i], m_,
+                     r_offs_[i]);
         }
     }
     //! This function set initially the operation for apply() in filter
@@ -105,21 +122,33 @@ public:
     void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                std::size_t locked) override
     {
+        applyChunk(alpha, beta, offset, block, locked, true);
+    }
+
+    //! The local computation of ChaseMpiDLA::applyChunk(), the operation is
+    //! switched after the `last` chunk only.
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
+    {
 
         T Zero = T(0.0);
 
-        if (next_ == NextOp::bAc)
+        if (single_)
+        {
+            applySingle(alpha, beta, offset, block, locked);
+        }
+        else if (next_ == NextOp::bAc)
         {
 
             if (mpi_col_rank != 0)
             {
                 beta = Zero;
             }
-            t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, n_,
-                      static_cast<std::size_t>(block), m_, &alpha, H_, ldh_,
-                      C_ + offset * m_ + locked * m_, m_, &beta,
-                      B_ + locked * n_ + offset * n_, n_);
-            next_ = NextOp::cAb;
+            hemm(CblasConjTrans, block, alpha, C_ + offset * m_ + locked * m_,
+                 m_, beta, B_ + locked * n_ + offset * n_, n_);
+            shiftDiagonal(false, block, alpha * conjugate(shift_),
+                          C_ + offset * m_ + locked * m_, m_,
+                          B_ + locked * n_ + offset * n_, n_);
         }
         else
         {
@@ -128,39 +157,65 @@ public:
             {
                 beta = Zero;
             }
-            t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m_,
-                   static_cast<std::size_t>(block), n_, &alpha, H_, ldh_,
-                   B_ + offset * n_ + locked * n_, n_, &beta,
-                   C_ + offset * m_ + locked * m_, m_);
-            next_ = NextOp::bAc;
+            hemm(CblasNoTrans, block, alpha, B_ + offset * n_ + locked * n_,
+                 n_, beta, C_ + offset * m_ + locked * m_, m_);
+            shiftDiagonal(true, block, alpha * shift_,
+                          B_ + offset * n_ + locked * n_, n_,
+                          C_ + offset * m_ + locked * m_, m_);
+        }
+
+        if (last)
+        {
+            next_ = (next_ == NextOp::bAc) ? NextOp::cAb : NextOp::bAc;
         }
     }
 
-    //! This function performs the shift of diagonal of a global matrix
-    //! - This global is already distributed, so the shifting operation takes
-    //! place on the local
-    //!   block of global matrix on each MPI proc.
-    //! - This function is naturally in parallel among all MPI procs.
+    //! The shift is only recorded: it is folded into applyChunk() as an
+    //! update of the locally owned diagonal entries, such that neither `H`
+    //! nor its single-precision copy is ever modified.
     void shiftMatrix(T c, bool isunshift = false) override
     {
+        if (isunshift)
+        {
+            shift_ = T(0.0);
+        }
+        else
+        {
+            shift_ += c;
+        }
+    }
 
-        for (std::size_t j = 0; j < nblocks_; j++)
+    //! - This function converts the local part of `H` (if it has not been
+    //! converted yet since the last Start()) and the non-converged vectors in
+    //! `C_` into the single-precision buffers of ChaseMpiMatrices.
+    //! - It is not supported if `H` is not stored explicitly.
+    bool enterSinglePrecision(std::size_t locked) override
+    {
+        if (H_ == nullptr || std::is_same<T, Single<T>>::value)
         {
-            for (std::size_t i = 0; i < mblocks_; i++)
-            {
-                for (std::size_t q = 0; q < c_lens_[j]; q++)
-                {
-                    for (std::size_t p = 0; p < r_lens_[i]; p++)
-                    {
-                        if (q + c_offs_[j] == p + r_offs_[i])
-                        {
-                            H_[(q + c_offs_l_[j]) * ldh_ + p + r_offs_l_[i]] +=
-                                c;
-                        }
-                    }
-                }
-            }
+            return false;
+        }
+
+        matrices_.allocate_single();
+        if (!Hs_valid_)
+        {
+            t_lag2(m_, n_, H_, ldh_, matrices_.Hs().ptr(), m_);
+            Hs_valid_ = true;
         }
+
+        t_lag2(m_, nev_ + nex_ - locked, C_ + locked * m_, m_,
+               matrices_.Cs().ptr() + locked * m_, m_);
+
+        single_ = true;
+        return true;
+    }
+
+    //! It converts the filtered vectors back into `C_`.
+    void leaveSinglePrecision(std::size_t locked) override
+    {
+        t_lag2(m_, nev_ + nex_ - locked, matrices_.Cs().ptr() + locked * m_,
+               m_, C_ + locked * m_, m_);
+        single_ = false;
     }
     //! - This function performs the local computation of `GEMM` for
     //! ChaseMpiDLA::asynCxHGatherC()
@@ -171,9 +226,8 @@ public:
         T alpha = T(1.0);
         T beta = T(0.0);
 
-        t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, n_,
-                  static_cast<std::size_t>(block), m_, &alpha, H_, ldh_,
-                  C_ + locked * m_, m_, &beta, B_ + locked * n_, n_);
+        hemm(CblasConjTrans, block, alpha, C_ + locked * m_, m_, beta,
+             B_ + locked * n_, n_);
     }
 
     //! - All required operations for this function has been done in for
@@ -183,14 +237,7 @@ public:
     {
         T alpha = T(1.0);
         T beta = T(0.0);
-        std::size_t k = n;
-        // t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, n_,
-        //          k, m_, &alpha, H_, ldh_,
-        //          v, m_, &beta, w, n_);
-        t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, n_,
-                  k, m_, &alpha, H_, ldh_,
-                  v, m_, &beta, w, n_);
-
+        hemm(CblasConjTrans, n, alpha, v, m_, beta, w, n_);
     }
 
     bool checkSymmetryEasy() override 
@@ -201,7 +248,7 @@ public:
     void symOrHermMatrix(char uplo) override {}
 
     int get_nprocs() const override { return matrix_properties_->get_nprocs(); }
-    void Start() override {}
+    void Start() override { Hs_valid_ = false; }
     void End() override {}
     Base<T>* get_Resids() override { return resid_; }
     Base<T>* get_Ritzv() override { return ritzv_; }
@@ -283,6 +330,38 @@ public:
         }
     }
 
+    //! - This function performs the local computation of the residuals for
+    //! ChaseMpiDLA::RRResd()
+    //! - On entry, `B_` and `B2_` hold `H*C2_` and `C2_` in the layout of
+    //! `B_`, and `A_` the eigenvectors of the reduced problem.
+    //! - It is implemented based on `BLAS`'s `?gemm`, `?axpy` and `?nrm2`.
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        T One = T(1.0);
+        T Zero = T(0.0);
+
+        if (!W_)
+        {
+            W_ = std::make_unique<Matrix<T>>(0, n_, nev_ + nex_);
+        }
+        T* W = W_->ptr();
+
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n_, block, block,
+               &One, B_ + locked * n_, n_, A_, nev_ + nex_, &Zero, W, n_);
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n_, block, block,
+               &One, B2_ + locked * n_, n_, A_, nev_ + nex_, &Zero,
+               B_ + locked * n_, n_);
+
+        for (auto i = 0; i < block; i++)
+        {
+            T alpha = -ritzv[i];
+            t_axpy(n_, &alpha, B_ + locked * n_ + i * n_, 1, W + i * n_, 1);
+
+            resid[i] = t_norm_p2(n_, W + i * n_);
+        }
+    }
+
     //! - This function performs the local computation for ChaseMpiDLA::heevd()
     //! - It is implemented based on `BLAS`'s `?gemm` and LAPACK's `?sy(he)evd`.
     void heevd(int matrix_layout, char jobz, char uplo, std::size_t n, T* a,
@@ -301,6 +380,9 @@ public:
     //! ChaseMpiDLA::hhQR().
     //! - This function contains nothing in this class.
     void hhQR(std::size_t locked) override {}
+    //! This function is not used by ChaseMpiDLA, which implements
+    //! ChaseMpiDLA::tsQR() itself.
+    void tsQR(std::size_t locked) override {}
     int cholQR1(std::size_t locked) override
     {
         return 0;
@@ -326,6 +408,7 @@ public:
     //! ChaseMpiDLA::Swap().
     //! - This function contains nothing in this class.
     void Swap(std::size_t i, std::size_t j) override {}
+    void Permute(const std::vector<std::size_t>& perm) override {}
     //! - All required operations for this function has been done in for
     //! ChaseMpiDLA::LanczosDos().
     //! - This function contains nothing in this class.
@@ -353,10 +436,19 @@ public:
                         std::size_t block) override
     {}
     
+    //! The full copies, which pack and unpack the redistributions of
+    //! ChaseMpiDLA, are threaded by t_lacpy_par().
     void lacpy(char uplo, std::size_t m, std::size_t n, T* a, std::size_t lda,
                T* b, std::size_t ldb) override
     {
-        t_lacpy(uplo, m, n, a, lda, b, ldb);
+        if (uplo == 'A')
+        {
+            t_lacpy_par(m, n, a, lda, b, ldb);
+        }
+        else
+        {
+            t_lacpy(uplo, m, n, a, lda, b, ldb);
+        }
     }
 
     void shiftMatrixForQR(T* A, std::size_t n, T shift) override
@@ -399,11 +491,8 @@ public:
     {
         T alpha = T(1.0);
         T beta = T(0.0);
-        std::size_t k = n;
-        t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, n_,
-                  k, m_, &alpha, H_, ldh_,
-                  v->ptr(), v->ld(), &beta, w->ptr(), w->ld());
-
+        hemm(CblasConjTrans, n, alpha, v->ptr(), v->ld(), beta, w->ptr(),
+             w->ld());
     }
 
     void dot_batch(std::size_t n, Matrix<T>* x, std::size_t incx, Matrix<T>* y,
@@ -426,7 +515,90 @@ public:
         }
     }    
 
-private:
+protected:
+    //! Computes the local product with the block of `H` owned by this MPI
+    //! proc on `k` vectors:
+    //! - `Y = alpha * H^H * X + beta * Y` for `transa = CblasConjTrans`, with
+    //! `X` of size `m_ * k` and `Y` of size `n_ * k`,
+    //! - `Y = alpha * H * X + beta * Y` for `transa = CblasNoTrans`, with
+    //! `X` of size `n_ * k` and `Y` of size `m_ * k`.
+    //!
+    //! Derived classes storing `H` in another format override it.
+    virtual void hemm(CBLAS_TRANSPOSE transa, std::size_t k, T alpha, T* X,
+                      std::size_t ldx, T beta, T* Y, std::size_t ldy)
+    {
+        std::size_t rows = (transa == CblasNoTrans) ? m_ : n_;
+        std::size_t cols = (transa == CblasNoTrans) ? n_ : m_;
+        t_gemm<T>(CblasColMajor, transa, CblasNoTrans, rows, k, cols, &alpha,
+                  H_, ldh_, X, ldx, &beta, Y, ldy);
+    }
+
+    //! The single-precision counterpart of applyChunk() on the buffers `Hs`,
+    //! `Cs` and `Bs` of ChaseMpiMatrices, it does not switch the operation.
+    void applySingle(T alpha, T beta, std::size_t offset, std::size_t block,
+                     std::size_t locked)
+    {
+        Single<T> alpha_s = static_cast<Single<T>>(alpha);
+        Single<T> beta_s = static_cast<Single<T>>(beta);
+        Single<T> Zero = Single<T>(0.0);
+        Single<T>* Hs = matrices_.Hs().ptr();
+        Single<T>* Cs = matrices_.Cs().ptr() + (offset + locked) * m_;
+        Single<T>* Bs = matrices_.Bs().ptr() + (offset + locked) * n_;
+
+        if (next_ == NextOp::bAc)
+        {
+            if (mpi_col_rank != 0)
+            {
+                beta_s = Zero;
+            }
+            t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, n_, block, m_,
+                   &alpha_s, Hs, m_, Cs, m_, &beta_s, Bs, n_);
+            shiftDiagonal(false, block,
+                          static_cast<Single<T>>(alpha * conjugate(shift_)), Cs,
+                          m_, Bs, n_);
+        }
+        else
+        {
+            if (mpi_row_rank != 0)
+            {
+                beta_s = Zero;
+            }
+            t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m_, block, n_,
+                   &alpha_s, Hs, m_, Bs, n_, &beta_s, Cs, m_);
+            shiftDiagonal(true, block,
+                          static_cast<Single<T>>(alpha * shift_), Bs, n_, Cs,
+                          m_);
+        }
+    }
+
+    //! It adds `s` times the diagonal part of `X` to `Y`, on the global
+    //! diagonal entries owned by this MPI proc, which are listed in `diag_`:
+    //! - `Y[col] += s * X[row]` for `notrans = false` (`X` is `m_ * k`),
+    //! - `Y[row] += s * X[col]` for `notrans = true` (`X` is `n_ * k`).
+    //!
+    //! Every global diagonal entry is owned by exactly one MPI proc, thus the
+    //! shift is accounted for exactly once in the following reduction.
+    template <typename U>
+    void shiftDiagonal(bool notrans, std::size_t k, U s, const U* X,
+                       std::size_t ldx, U* Y, std::size_t ldy)
+    {
+        if (s == U(0.0))
+        {
+            return;
+        }
+
+#pragma omp parallel for
+        for (std::size_t j = 0; j < k; j++)
+        {
+            for (auto& d : diag_)
+            {
+                std::size_t row = notrans ? d.first : d.second;
+                std::size_t col = notrans ? d.second : d.first;
+                Y[row + j * ldy] += s * X[col + j * ldx];
+            }
+        }
+    }
+
     enum NextOp
     {
         cAb,
@@ -481,6 +653,14 @@ private:
     ChaseMpiProperties<T>*
         matrix_properties_; //!< an object of class ChaseMpiProperties
     ChaseMpiMatrices<T> matrices_;
+    std::unique_ptr<Matrix<T>> W_; //!< a matrix of size `n_*(nev_+nex_)`,
+                                   //!< allocated on first use by RRResd()
+    bool single_ = false;   //!< if apply() runs in single precision
+    bool Hs_valid_ = false; //!< if `Hs` holds a copy of the current `H_`
+    T shift_ = T(0.0);      //!< accumulated shift of the diagonal of `H`
+    std::vector<std::pair<std::size_t, std::size_t>>
+        diag_; //!< local (row, column) of the global diagonal entries owned
+               //!< by this MPI proc
 };
 
 template <typename T>
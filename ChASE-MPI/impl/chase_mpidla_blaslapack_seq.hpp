@@ -61,15 +61,7 @@ public:
     }
     void initRndVecs() override
     {
-        std::mt19937 gen(1337.0);
-        std::normal_distribution<> d;
-        for (auto j = 0; j < (nev_ + nex_); j++)
-        {
-            for (auto i = 0; i < N_; i++)
-            {
-                C_[i + j * N_] = getRandomT<T>([&]() { return d(gen); });
-            }
-        }
+        ChaseRandom(1337).fill(N_, nev_ + nex_, C_, N_, 0);
     }
 
     void preApplication(T* V, std::size_t const locked,
@@ -83,15 +75,18 @@ public:
     void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                std::size_t locked) override
     {
+        applyChunk(alpha, beta, offset, block, locked, true);
+    }
 
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
+    {
         if (next_ == NextOp::bAc)
         {
             t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, N_,
                    static_cast<std::size_t>(block), N_, &alpha, H_, ldh_,
                    C_ + offset * N_ + locked * N_, N_, &beta,
                    B_ + locked * N_ + offset * N_, N_);
-
-            next_ = NextOp::cAb;
         }
         else
         {
@@ -99,11 +94,18 @@ public:
                    static_cast<std::size_t>(block), N_, &alpha, H_, ldh_,
                    B_ + offset * N_ + locked * N_, N_, &beta,
                    C_ + offset * N_ + locked * N_, N_);
+        }
 
-            next_ = NextOp::bAc;
+        if (last)
+        {
+            next_ = (next_ == NextOp::bAc) ? NextOp::cAb : NextOp::bAc;
         }
     }
 
+    //! Not supported, apply() keeps running in the working precision.
+    bool enterSinglePrecision(std::size_t locked) override { return false; }
+    void leaveSinglePrecision(std::size_t locked) override {}
+
     void shiftMatrix(T const c, bool isunshift = false) override
     {
         for (std::size_t i = 0; i < N_; ++i)
@@ -244,18 +246,19 @@ public:
 
         this->asynCxHGatherC(locked, block);
 
-        auto A = std::unique_ptr<T[]>{new T[block * block]};
+        T* A = matrices_.workspace().template get<T>(WorkspaceSlot::Block,
+                                                     block * block);
 
         // A <- W' * V
         t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, block, block, N_,
-               &One, B2_ + locked * N_, N_, B_ + locked * N_, N_, &Zero,
-               A.get(), block);
+               &One, B2_ + locked * N_, N_, B_ + locked * N_, N_, &Zero, A,
+               block);
 
-        t_heevd(LAPACK_COL_MAJOR, 'V', 'L', block, A.get(), block, ritzv);
+        t_heevd(LAPACK_COL_MAJOR, 'V', 'L', block, A, block, ritzv);
 
         t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, block,
-               &One, C2_ + locked * N_, N_, A.get(), block, &Zero,
-               C_ + locked * N_, N_);
+               &One, C2_ + locked * N_, N_, A, block, &Zero, C_ + locked * N_,
+               N_);
 
         std::memcpy(C2_ + locked * N_, C_ + locked * N_,
                     N_ * block * sizeof(T));
@@ -301,16 +304,57 @@ public:
         }
     }
 
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        T One = T(1.0);
+        T Zero = T(0.0);
+
+        this->asynCxHGatherC(locked, block);
+
+        // A <- W' * V
+        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, block, block, N_,
+               &One, B2_ + locked * N_, N_, B_ + locked * N_, N_, &Zero, A_,
+               nev_ + nex_);
+
+        t_heevd(LAPACK_COL_MAJOR, 'V', 'L', block, A_, nev_ + nex_, ritzv);
+
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, block,
+               &One, C2_ + locked * N_, N_, A_, nev_ + nex_, &Zero,
+               C_ + locked * N_, N_);
+
+        std::memcpy(C2_ + locked * N_, C_ + locked * N_,
+                    N_ * block * sizeof(T));
+
+        // H * (C2 * A) = (H * C2) * A, the copy of C2 in B2 is not needed
+        // anymore
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, block,
+               &One, B_ + locked * N_, N_, A_, nev_ + nex_, &Zero,
+               B2_ + locked * N_, N_);
+
+        for (std::size_t i = 0; i < block; ++i)
+        {
+            T beta = T(-ritzv[i]);
+            t_axpy(N_, &beta, (C_ + locked * N_) + N_ * i, 1,
+                   (B2_ + locked * N_) + N_ * i, 1);
+
+            resid[i] = nrm2(N_, (B2_ + locked * N_) + N_ * i, 1);
+        }
+    }
+
     void hhQR(std::size_t locked) override
     {
         auto nevex = nev_ + nex_;
 
-        std::unique_ptr<T[]> tau(new T[nevex]);
+        T* tau = matrices_.workspace().template get<T>(WorkspaceSlot::Tau, nevex);
 
-        t_geqrf(LAPACK_COL_MAJOR, N_, nevex, C_, N_, tau.get());
-        t_gqr(LAPACK_COL_MAJOR, N_, nevex, nevex, C_, N_, tau.get());
+        t_geqrf(LAPACK_COL_MAJOR, N_, nevex, C_, N_, tau);
+        t_gqr(LAPACK_COL_MAJOR, N_, nevex, nevex, C_, N_, tau);
     }
 
+    //! All the rows are local, such that TSQR is a single Householder QR.
+    void tsQR(std::size_t locked) override { hhQR(locked); }
+
     int cholQR1(std::size_t locked) override
     {
         auto nevex = nev_ + nex_;
@@ -401,22 +445,25 @@ public:
     void estimated_cond_evaluator(std::size_t locked, Base<T> cond)
     {
         auto nevex = nev_ + nex_;
-        std::vector<Base<T>> S(nevex - locked);
-        std::vector<Base<T>> norms(nevex - locked);
-        std::vector<T> V2(N_ * (nevex));
-        V2.assign(C_, C_ + N_ * nevex);
+        Workspace& ws = matrices_.workspace();
+        Base<T>* S =
+            ws.template get<Base<T>>(WorkspaceSlot::Singular, nevex - locked);
+        Base<T>* norms =
+            ws.template get<Base<T>>(WorkspaceSlot::Norms, nevex - locked);
+        T* V2 = ws.template get<T>(WorkspaceSlot::Redundant, N_ * nevex);
+        std::memcpy(V2, C_, N_ * nevex * sizeof(T));
         T* U;
         std::size_t ld = 1;
         T* Vt;
-        t_gesvd('N', 'N', N_, nevex - locked, V2.data() + N_ * locked,
-                N_, S.data(), U, ld, Vt, ld);
-        
+        t_gesvd('N', 'N', N_, nevex - locked, V2 + N_ * locked, N_, S, U, ld,
+                Vt, ld);
+
         for (auto i = 0; i < nevex - locked; i++)
         {
             norms[i] = std::sqrt(t_sqrt_norm(S[i]));
         }
-        
-        std::sort(norms.begin(), norms.end());
+
+        std::sort(norms, norms + nevex - locked);
 
         std::cout << "estimate: " << cond << ", rcond: "
                     << norms[nev_ + nex_ - locked - 1] / norms[0]
@@ -434,7 +481,7 @@ public:
 
     void Swap(std::size_t i, std::size_t j) override
     {
-        T* tmp = new T[N_];
+        T* tmp = matrices_.workspace().template get<T>(WorkspaceSlot::Column, N_);
 
         memcpy(tmp, C_ + N_ * i, N_ * sizeof(T));
         memcpy(C_ + N_ * i, C_ + N_ * j, N_ * sizeof(T));
@@ -443,8 +490,20 @@ public:
         memcpy(tmp, C2_ + N_ * i, N_ * sizeof(T));
         memcpy(C2_ + N_ * i, C2_ + N_ * j, N_ * sizeof(T));
         memcpy(C2_ + N_ * j, tmp, N_ * sizeof(T));
+    }
 
-        delete[] tmp;
+    void Permute(const std::vector<std::size_t>& perm) override
+    {
+        T* tmp = matrices_.workspace().template get<T>(WorkspaceSlot::Column, N_);
+        for (T* V : {C_, C2_})
+        {
+            auto col = [&](std::size_t k) {
+                return k == perm.size() ? tmp : V + N_ * k;
+            };
+            permute_columns(perm, [&](std::size_t dst, std::size_t src) {
+                std::memcpy(col(dst), col(src), N_ * sizeof(T));
+            });
+        }
     }
 
     void LanczosDos(std::size_t idx, std::size_t m, T* ritzVc) override
@@ -472,9 +531,9 @@ public:
         std::vector<T> alpha(numvec, T(1.0));
         std::vector<T> beta(numvec, T(0.0));
 
-        v_0 = new Matrix<T>(0, N_, numvec);
-        v_1 = new Matrix<T>(0, N_, numvec);
-        v_2 = new Matrix<T>(0, N_, numvec);
+        v_0 = matrices_.scratch(WorkspaceSlot::LanczosV0, 0, N_, numvec);
+        v_1 = matrices_.scratch(WorkspaceSlot::LanczosV1, 0, N_, numvec);
+        v_2 = matrices_.scratch(WorkspaceSlot::LanczosV2, 0, N_, numvec);
 
         std::memcpy(v_1->ptr(), C_, N_ * numvec * sizeof(T));
         this->nrm2_batch(N_, v_1, 1, numvec, real_alpha.data());
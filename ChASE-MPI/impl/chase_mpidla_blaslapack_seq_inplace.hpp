@@ -9,6 +9,7 @@
 
 #include <cstring>
 #include <memory>
+#include <type_traits>
 
 #include "ChASE-MPI/chase_mpidla_interface.hpp"
 
@@ -57,15 +58,7 @@ public:
     }
     void initRndVecs() override
     {
-        std::mt19937 gen(1337.0);
-        std::normal_distribution<> d;
-        for (auto j = 0; j < (nev_ + nex_); j++)
-        {
-            for (auto i = 0; i < N_; i++)
-            {
-                V1_[i + j * N_] = getRandomT<T>([&]() { return d(gen); });
-            }
-        }
+        ChaseRandom(1337).fill(N_, nev_ + nex_, V1_, N_, 0);
     }
 
     void preApplication(T* V, std::size_t locked, std::size_t block) override
@@ -77,16 +70,89 @@ public:
     void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                std::size_t locked) override
     {
-        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_,
-               static_cast<std::size_t>(block), N_, &alpha, H_, ldh_,
-               V1_ + offset * N_ + locked * N_, N_, &beta,
-               V2_ + locked * N_ + offset * N_, N_);
+        applyChunk(alpha, beta, offset, block, locked, true);
+    }
 
-        std::swap(V1_, V2_);
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
+    {
+        if (single_)
+        {
+            Single<T> alpha_s = static_cast<Single<T>>(alpha);
+            Single<T> beta_s = static_cast<Single<T>>(beta);
+
+            t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, N_,
+                   &alpha_s, matrices_.Hs().ptr(), N_,
+                   V1s_ + offset * N_ + locked * N_, N_, &beta_s,
+                   V2s_ + locked * N_ + offset * N_, N_);
+
+            if (last)
+            {
+                std::swap(V1s_, V2s_);
+            }
+            return;
+        }
+
+        hemm(CblasNoTrans, block, alpha, V1_ + offset * N_ + locked * N_, N_,
+             beta, V2_ + locked * N_ + offset * N_, N_);
+
+        if (last)
+        {
+            std::swap(V1_, V2_);
+        }
+    }
+
+    bool enterSinglePrecision(std::size_t locked) override
+    {
+        if (H_ == nullptr || std::is_same<T, Single<T>>::value)
+        {
+            return false;
+        }
+
+        matrices_.allocate_single();
+        if (!Hs_valid_)
+        {
+            t_lag2(N_, N_, H_, ldh_, matrices_.Hs().ptr(), N_);
+            Hs_valid_ = true;
+        }
+
+        V1s_ = matrices_.Cs().ptr();
+        V2s_ = matrices_.Bs().ptr();
+        t_lag2(N_, maxblock_ - locked, V1_ + locked * N_, N_,
+               V1s_ + locked * N_, N_);
+
+        single_ = true;
+        return true;
+    }
+
+    void leaveSinglePrecision(std::size_t locked) override
+    {
+        t_lag2(N_, maxblock_ - locked, V1s_ + locked * N_, N_,
+               V1_ + locked * N_, N_);
+        single_ = false;
     }
 
     void shiftMatrix(T const c, bool isunshift = false) override
     {
+        if (single_)
+        {
+            // the diagonal is restored from `H_` rather than shifted back, so
+            // that no rounding error accumulates in `Hs` along the iterations
+            Single<T>* Hs = matrices_.Hs().ptr();
+            for (std::size_t i = 0; i < N_; ++i)
+            {
+                if (isunshift)
+                {
+                    Hs[i + i * N_] = static_cast<Single<T>>(H_[i + i * ldh_]);
+                }
+                else
+                {
+                    Hs[i + i * N_] += static_cast<Single<T>>(c);
+                }
+            }
+            return;
+        }
+
         for (std::size_t i = 0; i < N_; ++i)
         {
             H_[i + i * ldh_] += c;
@@ -103,13 +169,7 @@ public:
         T One = T(1.0);
         T Zero = T(0.0);
 
-        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, //
-               N_, n, N_,                                 //
-               &One,                                      //
-               H_, ldh_,                                  //
-               B, N_,                                     //
-               &Zero,                                     //
-               C, N_);
+        hemm(CblasNoTrans, n, One, B, N_, Zero, C, N_);
     }
 
     bool checkSymmetryEasy() override 
@@ -128,21 +188,8 @@ public:
         T One = T(1.0);
         T Zero = T(0.0);
 
-        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, //
-               N_, 1, N_,                                 //
-               &One,                                      //
-               H_, ldh_,                                  //
-               v.data(), N_,                             //
-               &Zero,                                     //
-               u.data(), N_);
-
-        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, //
-               N_, 1, N_,                                 //
-               &One,                                      //
-               H_, ldh_,                                  //
-               v.data(), N_,                             //
-               &Zero,                                     //
-               uT.data(), N_);
+        hemm(CblasNoTrans, 1, One, v.data(), N_, Zero, u.data(), N_);
+        hemm(CblasConjTrans, 1, One, v.data(), N_, Zero, uT.data(), N_);
 
         bool is_sym = true;
         for(auto i = 0; i < N_; i++)
@@ -181,7 +228,7 @@ public:
     }
 
     int get_nprocs() const override { return 1; }
-    void Start() override {}
+    void Start() override { Hs_valid_ = false; }
     void End() override {}
     Base<T>* get_Resids() override { return matrices_.Resid().ptr(); }
     Base<T>* get_Ritzv() override { return matrices_.Ritzv().ptr(); }
@@ -213,8 +260,8 @@ public:
         T One = T(1.0);
         T Zero = T(0.0);
 
-        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, N_, block, N_, &One,
-               H_, ldh_, V1_ + locked * N_, N_, &Zero, V2_ + locked * N_, N_);
+        hemm(CblasConjTrans, block, One, V1_ + locked * N_, N_, Zero,
+             V2_ + locked * N_, N_);
 
         // A <- W' * V
         t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, block, block, N_,
@@ -258,9 +305,8 @@ public:
         T alpha = T(1.0);
         T beta = T(0.0);
 
-        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, N_, unconverged, N_,
-               &alpha, H_, ldh_, V1_ + locked * N_, N_, &beta,
-               V2_ + locked * N_, N_);
+        hemm(CblasConjTrans, unconverged, alpha, V1_ + locked * N_, N_, beta,
+             V2_ + locked * N_, N_);
 
         for (std::size_t i = 0; i < unconverged; ++i)
         {
@@ -272,18 +318,62 @@ public:
         }
     }
 
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        T One = T(1.0);
+        T Zero = T(0.0);
+
+        if (!W_)
+        {
+            W_ = std::make_unique<Matrix<T>>(0, N_, nev_ + nex_);
+        }
+        T* W = W_->ptr();
+
+        hemm(CblasConjTrans, block, One, V1_ + locked * N_, N_, Zero,
+             V2_ + locked * N_, N_);
+
+        // A <- W' * V
+        t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, block, block, N_,
+               &One, V2_ + locked * N_, N_, V1_ + locked * N_, N_, &Zero, A_,
+               nev_ + nex_);
+
+        t_heevd(LAPACK_COL_MAJOR, 'V', 'L', block, A_, nev_ + nex_, ritzv);
+
+        // H * (V1 * A) = (H * V1) * A
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, block,
+               &One, V2_ + locked * N_, N_, A_, nev_ + nex_, &Zero, W, N_);
+
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N_, block, block,
+               &One, V1_ + locked * N_, N_, A_, nev_ + nex_, &Zero,
+               V2_ + locked * N_, N_);
+
+        std::swap(V1_, V2_);
+
+        for (std::size_t i = 0; i < block; ++i)
+        {
+            T beta = T(-ritzv[i]);
+            t_axpy(N_, &beta, (V1_ + locked * N_) + N_ * i, 1, W + N_ * i, 1);
+
+            resid[i] = nrm2(N_, W + N_ * i, 1);
+        }
+    }
+
     void hhQR(std::size_t locked) override
     {
         auto nevex = nev_ + nex_;
 
-        std::unique_ptr<T[]> tau(new T[nevex]);
+        T* tau = matrices_.workspace().template get<T>(WorkspaceSlot::Tau, nevex);
 
         std::memcpy(V2_, V1_, locked * N_ * sizeof(T));
 
-        t_geqrf(LAPACK_COL_MAJOR, N_, nevex, V1_, N_, tau.get());
-        t_gqr(LAPACK_COL_MAJOR, N_, nevex, nevex, V1_, N_, tau.get());
+        t_geqrf(LAPACK_COL_MAJOR, N_, nevex, V1_, N_, tau);
+        t_gqr(LAPACK_COL_MAJOR, N_, nevex, nevex, V1_, N_, tau);
     }
 
+    //! All the rows are local, such that TSQR is a single Householder QR.
+    void tsQR(std::size_t locked) override { hhQR(locked); }
+
     int cholQR1(std::size_t locked) override
     {
         auto nevex = nev_ + nex_;
@@ -384,22 +474,25 @@ public:
     void estimated_cond_evaluator(std::size_t locked, Base<T> cond)
     {
         auto nevex = nev_ + nex_;
-        std::vector<Base<T>> S(nevex - locked);
-        std::vector<Base<T>> norms(nevex - locked);
-        std::vector<T> V2(N_ * (nevex));
-        V2.assign(V1_, V1_ + N_ * nevex);
+        Workspace& ws = matrices_.workspace();
+        Base<T>* S =
+            ws.template get<Base<T>>(WorkspaceSlot::Singular, nevex - locked);
+        Base<T>* norms =
+            ws.template get<Base<T>>(WorkspaceSlot::Norms, nevex - locked);
+        T* V2 = ws.template get<T>(WorkspaceSlot::Redundant, N_ * nevex);
+        std::memcpy(V2, V1_, N_ * nevex * sizeof(T));
         T* U;
         std::size_t ld = 1;
         T* Vt;
-        t_gesvd('N', 'N', N_, nevex - locked, V2.data() + N_ * locked,
-                N_, S.data(), U, ld, Vt, ld);
-        
+        t_gesvd('N', 'N', N_, nevex - locked, V2 + N_ * locked, N_, S, U, ld,
+                Vt, ld);
+
         for (auto i = 0; i < nevex - locked; i++)
         {
             norms[i] = std::sqrt(t_sqrt_norm(S[i]));
         }
-        
-        std::sort(norms.begin(), norms.end());
+
+        std::sort(norms, norms + nevex - locked);
 
         std::cout << "estimate: " << cond << ", rcond: "
                     << norms[nev_ + nex_ - locked - 1] / norms[0]
@@ -415,13 +508,24 @@ public:
 
     void Swap(std::size_t i, std::size_t j) override
     {
-        T* tmp = new T[N_];
+        T* tmp = matrices_.workspace().template get<T>(WorkspaceSlot::Column, N_);
 
         memcpy(tmp, V1_ + N_ * i, N_ * sizeof(T));
         memcpy(V1_ + N_ * i, V1_ + N_ * j, N_ * sizeof(T));
         memcpy(V1_ + N_ * j, tmp, N_ * sizeof(T));
     }
 
+    void Permute(const std::vector<std::size_t>& perm) override
+    {
+        T* tmp = matrices_.workspace().template get<T>(WorkspaceSlot::Column, N_);
+        auto col = [&](std::size_t k) {
+            return k == perm.size() ? tmp : V1_ + N_ * k;
+        };
+        permute_columns(perm, [&](std::size_t dst, std::size_t src) {
+            std::memcpy(col(dst), col(src), N_ * sizeof(T));
+        });
+    }
+
     void LanczosDos(std::size_t idx, std::size_t m, T* ritzVc) override
     {
         T alpha = T(1.0);
@@ -447,9 +551,9 @@ public:
         std::vector<T> alpha(numvec, T(1.0));
         std::vector<T> beta(numvec, T(0.0));
 
-        v_0 = new Matrix<T>(0, N_, numvec);
-        v_1 = new Matrix<T>(0, N_, numvec);
-        v_2 = new Matrix<T>(0, N_, numvec);
+        v_0 = matrices_.scratch(WorkspaceSlot::LanczosV0, 0, N_, numvec);
+        v_1 = matrices_.scratch(WorkspaceSlot::LanczosV1, 0, N_, numvec);
+        v_2 = matrices_.scratch(WorkspaceSlot::LanczosV2, 0, N_, numvec);
 
         std::memcpy(v_1->ptr(), V1_, N_ * numvec * sizeof(T));
         this->nrm2_batch(N_, v_1, 1, numvec, real_alpha.data());
@@ -585,11 +689,8 @@ public:
     {
         T alpha = T(1.0);
         T beta = T(0.0);
-        std::size_t k = n;
-        t_gemm<T>(CblasColMajor, CblasConjTrans, CblasNoTrans, N_,
-                  k, N_, &alpha, H_, ldh_,
-                  v->ptr(), v->ld(), &beta, w->ptr(), w->ld());
-
+        hemm(CblasConjTrans, n, alpha, v->ptr(), v->ld(), beta, w->ptr(),
+             w->ld());
     }
 
     void dot_batch(std::size_t n, Matrix<T>* x, std::size_t incx, Matrix<T>* y,
@@ -611,8 +712,19 @@ public:
             t_axpy(N, &alpha[i], x->ptr() + i * x->ld(), incx, y->ptr() + i * y->ld(), incy);
         }
     }  
-              
-private:
+
+protected:
+    //! Computes `Y = alpha * op(H) * X + beta * Y` on a block of `n` vectors,
+    //! with `op(H)` being either `H` or `H^H`. This is the only place the
+    //! stored `H_` is read when applying the operator, so derived backends
+    //! which do not store `H` explicitly override it.
+    virtual void hemm(CBLAS_TRANSPOSE transa, std::size_t n, T alpha, T* X,
+                      std::size_t ldx, T beta, T* Y, std::size_t ldy)
+    {
+        t_gemm(CblasColMajor, transa, CblasNoTrans, N_, n, N_, &alpha, H_,
+               ldh_, X, ldx, &beta, Y, ldy);
+    }
+
     std::size_t N_;      //!< global dimension of the symmetric/Hermtian matrix
     std::size_t locked_; //!< number of converged eigenpairs
     std::size_t nev_;    //!< number of required eigenpairs
@@ -625,6 +737,12 @@ private:
     T* V2_; //!< a matrix of size `N_*(nev_+nex_)`
     Matrix<T> *v_0, *v_1, *v_2;
     ChaseMpiMatrices<T> matrices_;
+    std::unique_ptr<Matrix<T>> W_; //!< a matrix of size `N_*(nev_+nex_)`,
+                                   //!< allocated on first use by RRResd()
+    bool single_ = false;   //!< if apply() runs in single precision
+    bool Hs_valid_ = false; //!< if `Hs` holds a copy of the current `H_`
+    Single<T>* V1s_;        //!< single-precision counterpart of `V1_`
+    Single<T>* V2s_;        //!< single-precision counterpart of `V2_`
 };
 
 template <typename T>
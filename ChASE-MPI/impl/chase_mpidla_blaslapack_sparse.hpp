@@ -0,0 +1,288 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
+
+namespace chase
+{
+namespace mpi
+{
+
+//! @brief A sparse matrix of size `m * n` in block compressed sparse row
+//! (BSR) format.
+/*! The matrix is partitioned into dense blocks of size `bs * bs`, only the
+ * blocks with at least one nonzero entry are stored. Each block is stored in
+ * column-major order. The blocks at the lower/right border are padded with
+ * zeros when `m` or `n` is not a multiple of `bs`. `bs = 1` gives the plain
+ * CSR format.
+ */
+template <class T>
+class BSRMatrix
+{
+public:
+    BSRMatrix() : m_(0), n_(0), bs_(1), rowptr_(1, 0) {}
+
+    //! A constructor of BSRMatrix.
+    /*! @param m: number of rows.
+        @param n: number of columns.
+        @param bs: size of the dense blocks.
+        @param rowptr: an array of size `ceil(m/bs)+1`, the blocks of the
+       block row `I` are stored at positions `rowptr[I]` to `rowptr[I+1]-1`.
+        @param colidx: the block column index of each stored block.
+        @param vals: the entries of the stored blocks, of size
+       `colidx.size() * bs * bs`.
+    */
+    BSRMatrix(std::size_t m, std::size_t n, std::size_t bs,
+              std::vector<std::size_t> rowptr, std::vector<std::size_t> colidx,
+              std::vector<T> vals)
+        : m_(m), n_(n), bs_(bs), rowptr_(std::move(rowptr)),
+          colidx_(std::move(colidx)), vals_(std::move(vals))
+    {
+        if (bs_ == 0 || rowptr_.size() != mb() + 1 ||
+            rowptr_.back() != colidx_.size() ||
+            vals_.size() != colidx_.size() * bs_ * bs_)
+        {
+            throw std::invalid_argument("BSRMatrix: inconsistent arrays");
+        }
+    }
+
+    //! It builds a BSRMatrix from a dense column-major matrix `H`, keeping
+    //! the blocks which have at least one nonzero entry.
+    static BSRMatrix<T> fromDense(std::size_t m, std::size_t n, std::size_t bs,
+                                  const T* H, std::size_t ldh)
+    {
+        std::size_t mb = (m + bs - 1) / bs;
+        std::size_t nb = (n + bs - 1) / bs;
+        std::vector<std::size_t> rowptr(mb + 1, 0);
+        std::vector<std::size_t> colidx;
+        std::vector<T> vals;
+
+        for (std::size_t I = 0; I < mb; I++)
+        {
+            std::size_t rl = std::min(bs, m - I * bs);
+            for (std::size_t J = 0; J < nb; J++)
+            {
+                std::size_t cl = std::min(bs, n - J * bs);
+                const T* blk = H + I * bs + J * bs * ldh;
+                bool nonzero = false;
+                for (std::size_t c = 0; c < cl && !nonzero; c++)
+                {
+                    for (std::size_t r = 0; r < rl; r++)
+                    {
+                        if (blk[r + c * ldh] != T(0.0))
+                        {
+                            nonzero = true;
+                            break;
+                        }
+                    }
+                }
+                if (!nonzero)
+                {
+                    continue;
+                }
+
+                colidx.push_back(J);
+                vals.resize(vals.size() + bs * bs, T(0.0));
+                T* dst = vals.data() + vals.size() - bs * bs;
+                for (std::size_t c = 0; c < cl; c++)
+                {
+                    for (std::size_t r = 0; r < rl; r++)
+                    {
+                        dst[r + c * bs] = blk[r + c * ldh];
+                    }
+                }
+            }
+            rowptr[I + 1] = colidx.size();
+        }
+
+        return BSRMatrix<T>(m, n, bs, std::move(rowptr), std::move(colidx),
+                            std::move(vals));
+    }
+
+    //! It returns `A^H` in BSR format.
+    BSRMatrix<T> conjTranspose() const
+    {
+        std::size_t bs2 = bs_ * bs_;
+        std::vector<std::size_t> rowptr(nb() + 1, 0);
+        std::vector<std::size_t> colidx(nnzb());
+        std::vector<T> vals(nnzb() * bs2);
+
+        for (std::size_t z = 0; z < nnzb(); z++)
+        {
+            rowptr[colidx_[z] + 1]++;
+        }
+        for (std::size_t J = 0; J < nb(); J++)
+        {
+            rowptr[J + 1] += rowptr[J];
+        }
+
+        std::vector<std::size_t> pos(rowptr.begin(), rowptr.end() - 1);
+        for (std::size_t I = 0; I < mb(); I++)
+        {
+            for (std::size_t z = rowptr_[I]; z < rowptr_[I + 1]; z++)
+            {
+                std::size_t dst = pos[colidx_[z]]++;
+                colidx[dst] = I;
+                const T* a = vals_.data() + z * bs2;
+                T* at = vals.data() + dst * bs2;
+                for (std::size_t c = 0; c < bs_; c++)
+                {
+                    for (std::size_t r = 0; r < bs_; r++)
+                    {
+                        at[c + r * bs_] = conjugate(a[r + c * bs_]);
+                    }
+                }
+            }
+        }
+
+        return BSRMatrix<T>(n_, m_, bs_, std::move(rowptr), std::move(colidx),
+                            std::move(vals));
+    }
+
+    //! It computes `Y = alpha * A * X + beta * Y` for `k` vectors, in which
+    //! `X` is of size `n * k` and `Y` of size `m * k`. It is parallelized
+    //! with OpenMP over the block rows.
+    void spmm(std::size_t k, T alpha, const T* X, std::size_t ldx, T beta,
+              T* Y, std::size_t ldy) const
+    {
+        std::size_t bs2 = bs_ * bs_;
+        long mb_l = static_cast<long>(mb());
+
+#pragma omp parallel for schedule(dynamic, 16)
+        for (long I = 0; I < mb_l; I++)
+        {
+            std::size_t r0 = I * bs_;
+            std::size_t rl = std::min(bs_, m_ - r0);
+
+            for (std::size_t j = 0; j < k; j++)
+            {
+                T* y = Y + r0 + j * ldy;
+                for (std::size_t r = 0; r < rl; r++)
+                {
+                    y[r] = (beta == T(0.0)) ? T(0.0) : beta * y[r];
+                }
+            }
+
+            for (std::size_t z = rowptr_[I]; z < rowptr_[I + 1]; z++)
+            {
+                std::size_t c0 = colidx_[z] * bs_;
+                std::size_t cl = std::min(bs_, n_ - c0);
+                const T* blk = vals_.data() + z * bs2;
+
+                for (std::size_t j = 0; j < k; j++)
+                {
+                    const T* x = X + c0 + j * ldx;
+                    T* y = Y + r0 + j * ldy;
+                    for (std::size_t c = 0; c < cl; c++)
+                    {
+                        T xc = alpha * x[c];
+                        for (std::size_t r = 0; r < rl; r++)
+                        {
+                            y[r] += blk[r + c * bs_] * xc;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::size_t rows() const { return m_; }
+    std::size_t cols() const { return n_; }
+    std::size_t block_size() const { return bs_; }
+    //! number of block rows
+    std::size_t mb() const { return (m_ + bs_ - 1) / bs_; }
+    //! number of block columns
+    std::size_t nb() const { return (n_ + bs_ - 1) / bs_; }
+    //! number of stored blocks
+    std::size_t nnzb() const { return colidx_.size(); }
+
+private:
+    std::size_t m_;  //!< number of rows
+    std::size_t n_;  //!< number of columns
+    std::size_t bs_; //!< size of the dense blocks
+    std::vector<std::size_t> rowptr_; //!< block row pointers
+    std::vector<std::size_t> colidx_; //!< block column indices
+    std::vector<T> vals_;             //!< entries of the stored blocks
+};
+
+//! @brief A derived class of ChaseMpiDLABlaslapack whose local block of `H`
+//! is stored in BSR (or CSR) format instead of a dense `m_ * n_` array.
+/*! The local products of ChaseMpiDLABlaslapack::apply(),
+ * ChaseMpiDLABlaslapack::asynCxHGatherC() and
+ * ChaseMpiDLABlaslapack::applyVec() are performed by a threaded SpMM kernel,
+ * all the collective communication is still done by ChaseMpiDLA. The
+ * conjugate transpose of the local block is stored as well, so that both
+ * `H^H * C` and `H * B` are row-parallel without atomics. The shift of the
+ * diagonal is never applied to the stored entries, it is added on the fly to
+ * the products through the list of global diagonal entries owned by this
+ * MPI proc.
+ *
+ * It is used through the constructor of ChaseMpi which takes an existing
+ * ChaseMpiDLA, e.g.,
+ * @code
+ *   new ChaseMpiDLA<T>(props, new ChaseMpiDLABlaslapackSparse<T>(props, Hloc,
+ *                                                                V, ritzv))
+ * @endcode
+ */
+template <class T>
+class ChaseMpiDLABlaslapackSparse : public ChaseMpiDLABlaslapack<T>
+{
+public:
+    //! A constructor of ChaseMpiDLABlaslapackSparse.
+    //! @param matrix_properties: it is an object of ChaseMpiProperties, which
+    //! defines the MPI environment and data distribution scheme in ChASE-MPI.
+    //! @param H: the local block of the distributed matrix, of size
+    //! ChaseMpiProperties::get_m() `*` ChaseMpiProperties::get_n().
+    //! @param V1: a pointer to a rectangular matrix of size `m * (nev+nex)`.
+    //! @param ritzv: a pointer to an array to store the computed Ritz values.
+    ChaseMpiDLABlaslapackSparse(ChaseMpiProperties<T>* matrix_properties,
+                                BSRMatrix<T> H, T* V1, Base<T>* ritzv)
+        : ChaseMpiDLABlaslapack<T>(matrix_properties, nullptr,
+                                   matrix_properties->get_m(), V1, ritzv),
+          Hs_(std::move(H))
+    {
+        if (Hs_.rows() != this->m_ || Hs_.cols() != this->n_)
+        {
+            throw std::invalid_argument(
+                "ChaseMpiDLABlaslapackSparse: the local block must be of size "
+                "m * n");
+        }
+
+        HsH_ = Hs_.conjTranspose();
+    }
+
+protected:
+    //! The local products are computed by BSRMatrix::spmm() on the stored
+    //! block (`transa = CblasNoTrans`) or on its conjugate transpose
+    //! (`transa = CblasConjTrans`). The shift is added by the base class.
+    void hemm(CBLAS_TRANSPOSE transa, std::size_t k, T alpha, T* X,
+              std::size_t ldx, T beta, T* Y, std::size_t ldy) override
+    {
+        bool notrans = (transa == CblasNoTrans);
+        (notrans ? Hs_ : HsH_).spmm(k, alpha, X, ldx, beta, Y, ldy);
+    }
+
+private:
+    BSRMatrix<T> Hs_;  //!< the local block of `H`
+    BSRMatrix<T> HsH_; //!< the conjugate transpose of `Hs_`
+};
+
+template <typename T>
+struct is_skewed_matrixfree<ChaseMpiDLABlaslapackSparse<T>>
+{
+    static const bool value = true;
+};
+
+} // namespace mpi
+} // namespace chase
@@ -197,9 +197,6 @@ public:
         cublasSetPointerMode(cublasH2_, CUBLAS_POINTER_MODE_DEVICE);
         cublasSetStream(cublasH2_, stream_);
 
-        cuda_exec(
-            cudaMalloc((void**)&states_, sizeof(curandStatePhilox4_32_10_t) * (256 * 32)));
-
         cuda_exec(cudaMalloc((void**)&devInfo_, sizeof(int)));
         cuda_exec(cudaMalloc((void**)&d_return_, sizeof(T) * max_block_));
 
@@ -258,8 +255,6 @@ public:
             cudaFree(d_v1_);
         if (d_w_)
             cudaFree(d_w_);
-        if(states_)
-            cudaFree(states_);
 	cudaFreeHost(v0_);
 	cudaFreeHost(v1_);
 	cudaFreeHost(w_);
@@ -276,11 +271,13 @@ public:
                              cudaMemcpyDeviceToDevice));
         cublasSetMatrix(N_, N_, sizeof(T), H_, ldh_, d_H_, N_);    
     }
+    //! The random vectors are generated on the host by ChaseRandom, such
+    //! that they are the same as for the CPU backends, and copied to the GPU.
     void initRndVecs() override
     {
-	unsigned long long seed = 24141;
-        chase_rand_normal(seed, states_, d_V1_, N_ * (nev_ + nex_),
-                          (cudaStream_t)0);
+        ChaseRandom(1337).fill(N_, nev_ + nex_, V1_, N_, 0);
+        cuda_exec(cudaMemcpy(d_V1_, V1_, N_ * (nev_ + nex_) * sizeof(T),
+                             cudaMemcpyHostToDevice));
     }
 
     void preApplication(T* V, std::size_t locked, std::size_t block) override
@@ -292,6 +289,12 @@ public:
 
     void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                std::size_t locked) override
+    {
+        applyChunk(alpha, beta, offset, block, locked, true);
+    }
+
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
     {
         cublas_status_ =
             cublasTgemm(cublasH_, CUBLAS_OP_N, CUBLAS_OP_N, N_,
@@ -299,9 +302,16 @@ public:
                         d_V1_ + offset * N_ + locked * N_, N_, &beta,
                         d_V2_ + locked * N_ + offset * N_, N_);
         assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
-        std::swap(d_V1_, d_V2_);
+        if (last)
+        {
+            std::swap(d_V1_, d_V2_);
+        }
     }
 
+    //! Not supported, apply() keeps running in the working precision.
+    bool enterSinglePrecision(std::size_t locked) override { return false; }
+    void leaveSinglePrecision(std::size_t locked) override {}
+
     void shiftMatrix(T c, bool isunshift = false) override
     {
         chase_shift_matrix(d_H_, N_, std::real(c), &stream_);
@@ -518,6 +528,58 @@ public:
                              cudaMemcpyDeviceToHost));
     }
 
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        T One = T(1.0);
+        T Zero = T(0.0);
+
+        if (!W_)
+        {
+            W_ = std::make_unique<Matrix<T>>(2, N_, nev_ + nex_);
+        }
+        T* d_W = W_->device();
+
+        cublas_status_ = cublasTgemm(
+            cublasH_, CUBLAS_OP_C, CUBLAS_OP_N, N_, block, N_, &One, d_H_, N_,
+            d_V1_ + locked * N_, N_, &Zero, d_V2_ + locked * N_, N_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+
+        cublas_status_ =
+            cublasTgemm(cublasH_, CUBLAS_OP_C, CUBLAS_OP_N, block, block, N_,
+                        &One, d_V2_ + locked * N_, N_, d_V1_ + locked * N_, N_,
+                        &Zero, d_A_, max_block_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+        cusolver_status_ = cusolverDnTheevd(
+            cusolverH_, CUSOLVER_EIG_MODE_VECTOR, CUBLAS_FILL_MODE_LOWER, block,
+            d_A_, max_block_, d_ritz_, d_work_, lwork_, devInfo_);
+        assert(cusolver_status_ == CUSOLVER_STATUS_SUCCESS);
+
+        cuda_exec(cudaMemcpy(ritzv, d_ritz_, block * sizeof(Base<T>),
+                             cudaMemcpyDeviceToHost));
+
+        // H * (V1 * A) = (H * V1) * A
+        cublas_status_ =
+            cublasTgemm(cublasH_, CUBLAS_OP_N, CUBLAS_OP_N, N_, block, block,
+                        &One, d_V2_ + locked * N_, N_, d_A_, max_block_, &Zero,
+                        d_W, N_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+
+        cublas_status_ =
+            cublasTgemm(cublasH_, CUBLAS_OP_N, CUBLAS_OP_N, N_, block, block,
+                        &One, d_V1_ + locked * N_, N_, d_A_, max_block_, &Zero,
+                        d_V2_ + locked * N_, N_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+
+        std::swap(d_V1_, d_V2_);
+
+        residual_gpu(N_, block, d_W, N_, d_V1_ + locked * N_, N_, d_ritz_,
+                     d_resids_, true, (cudaStream_t)0);
+
+        cuda_exec(cudaMemcpy(resid, d_resids_, block * sizeof(Base<T>),
+                             cudaMemcpyDeviceToHost));
+    }
+
     void hhQR(std::size_t locked) override
     {
         auto nevex = nev_ + nex_;
@@ -534,6 +596,9 @@ public:
 
     }
 
+    //! All the rows are local, such that TSQR is a single Householder QR.
+    void tsQR(std::size_t locked) override { hhQR(locked); }
+
     int cholQR1(std::size_t locked) override
     {
         T one = T(1.0);
@@ -743,24 +808,27 @@ public:
     void estimated_cond_evaluator(std::size_t locked, Base<T> cond)
     {
         auto nevex = nev_ + nex_;
-        std::vector<Base<T>> S(nevex - locked);
-        std::vector<Base<T>> norms(nevex - locked);
-        std::vector<T> V2(N_ * (nevex));
-
-        cuda_exec(cudaMemcpy(V2.data(), d_V1_, N_ * nevex * sizeof(T),
+        Workspace& ws = matrices_.workspace();
+        Base<T>* S =
+            ws.template get<Base<T>>(WorkspaceSlot::Singular, nevex - locked);
+        Base<T>* norms =
+            ws.template get<Base<T>>(WorkspaceSlot::Norms, nevex - locked);
+        T* V2 = ws.template get<T>(WorkspaceSlot::Redundant, N_ * nevex);
+
+        cuda_exec(cudaMemcpy(V2, d_V1_, N_ * nevex * sizeof(T),
                                 cudaMemcpyDeviceToHost));
         T* U;
         std::size_t ld = 1;
         T* Vt;
-        t_gesvd('N', 'N', N_, nevex - locked, V2.data() + N_ * locked,
-                N_, S.data(), U, ld, Vt, ld);
-        
+        t_gesvd('N', 'N', N_, nevex - locked, V2 + N_ * locked, N_, S, U, ld,
+                Vt, ld);
+
         for (auto i = 0; i < nevex - locked; i++)
         {
             norms[i] = std::sqrt(t_sqrt_norm(S[i]));
         }
-        
-        std::sort(norms.begin(), norms.end());
+
+        std::sort(norms, norms + nevex - locked);
 
         std::cout << "estimate: " << cond << ", rcond: "
                     << norms[nev_ + nex_ - locked - 1] / norms[0]
@@ -786,6 +854,17 @@ public:
                              cudaMemcpyDeviceToDevice));
     }
 
+    void Permute(const std::vector<std::size_t>& perm) override
+    {
+        auto col = [&](std::size_t k) {
+            return k == perm.size() ? d_v1_ : d_V1_ + N_ * k;
+        };
+        permute_columns(perm, [&](std::size_t dst, std::size_t src) {
+            cuda_exec(cudaMemcpy(col(dst), col(src), N_ * sizeof(T),
+                                 cudaMemcpyDeviceToDevice));
+        });
+    }
+
     void LanczosDos(std::size_t idx, std::size_t m, T* ritzVc) override
     {
         T alpha = T(1.0);
@@ -813,9 +892,9 @@ public:
         std::vector<T> alpha(numvec, T(1.0));
         std::vector<T> beta(numvec, T(0.0));
 
-        v_0 = new Matrix<T>(2, N_, numvec);
-        v_1 = new Matrix<T>(2, N_, numvec);
-        v_2 = new Matrix<T>(2, N_, numvec);
+        v_0 = matrices_.scratch(WorkspaceSlot::LanczosV0, 2, N_, numvec);
+        v_1 = matrices_.scratch(WorkspaceSlot::LanczosV1, 2, N_, numvec);
+        v_2 = matrices_.scratch(WorkspaceSlot::LanczosV2, 2, N_, numvec);
 
         //std::memcpy(v_1->ptr(), V1_, N_ * numvec * sizeof(T));
     
@@ -1030,12 +1109,13 @@ private:
     cusolverDnHandle_t cusolverH_; //!< `cuSOLVER` handle
     bool copied_; //!< a flag indicates if the matrix has already been copied to
                   //!< device
-    curandStatePhilox4_32_10_t *states_ = NULL;
 
     ChaseMpiMatrices<T> matrices_;
 
     T *d_v0, *d_v1, *d_w;
     Matrix<T> *v_0, *v_1, *v_2;
+    std::unique_ptr<Matrix<T>> W_; //!< a matrix of size `N_*(nev_+nex_)` on
+                                   //!< GPU, allocated on first use by RRResd()
 
 };
 
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq_inplace.hpp"
+
+namespace chase
+{
+namespace mpi
+{
+
+//! A user-supplied operator acting on a block of vectors.
+/*! It computes `Y = alpha * (H - c * I) * X + beta * Y`, in which `X` and `Y`
+    are column-major matrices of size `N * block` with leading dimensions
+    `ldx` and `ldy`. The operator `H` must be Symmetric/Hermitian.
+*/
+template <class T>
+using MatrixFreeApply =
+    std::function<void(std::size_t block, T alpha, Base<T> c, T* X,
+                       std::size_t ldx, T beta, T* Y, std::size_t ldy)>;
+
+//! @brief A derived class of ChaseMpiDLABlaslapackSeqInplace which implements
+//! ChASE targeting shared-memory architectures without an explicitly stored
+//! matrix `H`.
+/*! Every application of `H` is forwarded to a MatrixFreeApply callback. The
+ * shifts required by the Chebyshev filter are never applied to any data:
+ * they are accumulated and passed to the callback as the scalar `c`. All
+ * the other dense kernels (QR, Rayleigh-Ritz, Lanczos) are inherited from
+ * ChaseMpiDLABlaslapackSeqInplace.
+ */
+template <class T>
+class ChaseMpiDLAMatrixFreeSeq : public ChaseMpiDLABlaslapackSeqInplace<T>
+{
+public:
+    //! A constructor of ChaseMpiDLAMatrixFreeSeq.
+    /*! @param op: the callback applying `H - c * I` to a block of vectors.
+        @param V1: a pointer to a matrix of size `n * (nev+nex)`, it is
+       allocated internally if `nullptr`.
+        @param ritzv: a pointer to an array of size `nev+nex`, it is
+       allocated internally if `nullptr`.
+        @param n: size of matrix defining the eigenproblem.
+        @param nev: number of required eigenpairs.
+        @param nex: number of extra searching space.
+    */
+    ChaseMpiDLAMatrixFreeSeq(MatrixFreeApply<T> op, T* V1, Base<T>* ritzv,
+                             std::size_t n, std::size_t nev, std::size_t nex)
+        : ChaseMpiDLABlaslapackSeqInplace<T>(nullptr, n, V1, ritzv, n, nev,
+                                             nex),
+          op_(std::move(op)), c_(0)
+    {
+    }
+
+    //! The shift is only recorded, `H` is left untouched.
+    void shiftMatrix(T const c, bool = false) override
+    {
+        c_ -= std::real(c);
+    }
+
+    //! The Symmetric/Hermitian property of the operator cannot be enforced
+    //! without storing it, so this is a no-op.
+    void symOrHermMatrix(char) override {}
+
+    //! It checks `y^H (H x) == conj(x^H (H y))` for two random vectors, up to
+    //! a rounding error tolerance.
+    bool checkSymmetryEasy() override
+    {
+        std::size_t N = this->N_;
+        std::vector<T> x(N), y(N), Hx(N), Hy(N);
+
+        ChaseRandom rnd(1337);
+        rnd.fill(N, 1, x.data(), N, 0, 0);
+        rnd.fill(N, 1, y.data(), N, 0, 1);
+
+        this->hemm(CblasNoTrans, 1, T(1.0), x.data(), N, T(0.0), Hx.data(), N);
+        this->hemm(CblasNoTrans, 1, T(1.0), y.data(), N, T(0.0), Hy.data(), N);
+
+        T yHx = t_dot(N, y.data(), 1, Hx.data(), 1);
+        T xHy = t_dot(N, x.data(), 1, Hy.data(), 1);
+
+        Base<T> tol = 10 * N * std::numeric_limits<Base<T>>::epsilon() *
+                      (t_nrm2(N, y.data(), 1) * t_nrm2(N, Hx.data(), 1) +
+                       t_nrm2(N, x.data(), 1) * t_nrm2(N, Hy.data(), 1));
+
+        return std::abs(yHx - conjugate(xHy)) <= tol;
+    }
+
+protected:
+    //! The operator is Symmetric/Hermitian, thus the transposition is
+    //! ignored.
+    void hemm(CBLAS_TRANSPOSE, std::size_t n, T alpha, T* X, std::size_t ldx,
+              T beta, T* Y, std::size_t ldy) override
+    {
+        op_(n, alpha, c_, X, ldx, beta, Y, ldy);
+    }
+
+private:
+    MatrixFreeApply<T> op_; //!< user-supplied application of `H - c_ * I`
+    Base<T> c_;             //!< accumulated shift, `H` is seen as `H - c_ * I`
+};
+
+template <typename T>
+struct is_skewed_matrixfree<ChaseMpiDLAMatrixFreeSeq<T>>
+{
+    static const bool value = false;
+};
+
+} // namespace mpi
+} // namespace chase
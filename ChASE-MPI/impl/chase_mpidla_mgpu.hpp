@@ -319,13 +319,9 @@ public:
         std::size_t maxBlock = matrix_properties_->get_max_block();
 
 #if defined(HAS_UM)
-        cuda_exec(cudaMallocManaged(
-            (void**)&states_, sizeof(curandStatePhilox4_32_10_t) * (256 * 32)));
         cuda_exec(cudaMallocManaged((void**)&d_v_, sizeof(T) * m_));
         cuda_exec(cudaMallocManaged((void**)&d_w_, sizeof(T) * n_));
 #else
-        cuda_exec(cudaMalloc((void**)&states_,
-                             sizeof(curandStatePhilox4_32_10_t) * (256 * 32)));
         cuda_exec(cudaMalloc((void**)&d_v_, sizeof(T) * m_));
         cuda_exec(cudaMalloc((void**)&d_w_, sizeof(T) * n_));
 #endif
@@ -440,7 +436,6 @@ public:
         cuda_exec(cudaFree(devInfo_));
         cuda_exec(cudaFree(d_off_m_));
         cuda_exec(cudaFree(d_off_n_));
-        cuda_exec(cudaFree(states_));
         cuda_exec(cudaFree(d_sum_));
 
         if (d_ritzVc_)
@@ -464,23 +459,19 @@ public:
         H__.H2D();
         next_ = NextOp::bAc;
     }
-    //! This function generates the random values for each MPI proc using device
-    //! API of cuRAND
-    //!     - each MPI proc with a same MPI rank among different column
-    //!     communicator
-    //!       same a same seed of RNG
+    //! This function generates the random values of the local rows of each
+    //! MPI proc on the host with the counter-based ChaseRandom, keyed by the
+    //! global row and column indices, and copies them to the GPU. The random
+    //! vectors are the same for any MPI grid and as for the CPU backends.
     void initRndVecs() override
     {
-        MPI_Comm col_comm = matrix_properties_->get_col_comm();
-        int mpi_col_rank;
-        MPI_Comm_rank(col_comm, &mpi_col_rank);
-        unsigned long long seed = 1337 + mpi_col_rank;
-
-        chase_rand_normal(seed, states_, C__.device(), m_ * (nev_ + nex_),
-                          (cudaStream_t)0);
-#if !defined(CUDA_AWARE)
-        C__.D2H(m_, nev_ + nex_);
-#endif
+        ChaseRandom rnd(1337);
+        for (std::size_t i = 0; i < mblocks_; i++)
+        {
+            rnd.fill(r_lens_[i], nev_ + nex_, C__.host() + r_offs_l_[i], m_,
+                     r_offs_[i]);
+        }
+        C__.H2D(m_, nev_ + nex_);
     }
 
     //! - This function set initially the operation for apply() in filter
@@ -501,6 +492,14 @@ public:
     //! - It is implemented based on `cuBLAS`'s `cublasXgemm`.
     void apply(T alpha, T beta, std::size_t offset, std::size_t block,
                std::size_t locked) override
+    {
+        applyChunk(alpha, beta, offset, block, locked, true);
+    }
+
+    //! The local computation of ChaseMpiDLA::applyChunk(), the operation is
+    //! switched after the `last` chunk only.
+    void applyChunk(T alpha, T beta, std::size_t offset, std::size_t block,
+                    std::size_t locked, bool last) override
     {
         // cudaStreamSynchronize(stream1_);
         T Zero = T(0.0);
@@ -522,7 +521,6 @@ public:
 #if !defined(CUDA_AWARE)
             B__.D2H(n_, block, locked + offset);
 #endif
-            next_ = NextOp::cAb;
         }
         else
         {
@@ -542,10 +540,18 @@ public:
 #if !defined(CUDA_AWARE)
             C__.D2H(m_, block, offset + locked);
 #endif
-            next_ = NextOp::bAc;
+        }
+
+        if (last)
+        {
+            next_ = (next_ == NextOp::bAc) ? NextOp::cAb : NextOp::bAc;
         }
     }
 
+    //! Not supported, apply() keeps running in the working precision.
+    bool enterSinglePrecision(std::size_t locked) override { return false; }
+    void leaveSinglePrecision(std::size_t locked) override {}
+
     //! This function performs the shift of diagonal of a global matrix
     //! - This global is already distributed on GPUs, so the shifting operation
     //! takes place on the local
@@ -790,6 +796,43 @@ public:
         }
 #endif
     }
+    //! - This function performs the local computation of the residuals for
+    //! ChaseMpiDLA::RRResd()
+    //! - On entry, `B__` and `B2__` hold `H*C2__` and `C2__` in the layout of
+    //! `B__` on device, and `A__` the eigenvectors of the reduced problem.
+    //! - It is implemented based on `cuBLAS`'s `cublasXgemm` and the residual
+    //! kernel on GPU.
+    void RRResd(std::size_t block, std::size_t locked, Base<T>* ritzv,
+                Base<T>* resid) override
+    {
+        T One = T(1.0);
+        T Zero = T(0.0);
+
+        if (!W__)
+        {
+            W__ = std::make_unique<Matrix<T>>(2, n_, nev_ + nex_);
+        }
+
+        cublas_status_ = cublasTgemm(
+            cublasH_, CUBLAS_OP_N, CUBLAS_OP_N, n_, block, block, &One,
+            B__.device() + locked * n_, n_, A__.device(), nev_ + nex_, &Zero,
+            W__->device(), n_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+        cublas_status_ = cublasTgemm(
+            cublasH_, CUBLAS_OP_N, CUBLAS_OP_N, n_, block, block, &One,
+            B2__.device() + locked * n_, n_, A__.device(), nev_ + nex_, &Zero,
+            B__.device() + locked * n_, n_);
+        assert(cublas_status_ == CUBLAS_STATUS_SUCCESS);
+
+        residual_gpu(n_, block, W__->device(), n_, B__.device() + locked * n_,
+                     n_, Ritzv__.device(), Resid__.device() + locked, false,
+                     (cudaStream_t)0);
+#if !defined(CUDA_AWARE)
+        cuda_exec(cudaMemcpy(resid, Resid__.device() + locked,
+                             block * sizeof(Base<T>), cudaMemcpyDeviceToHost));
+#endif
+    }
+
     //! - This function performs the local computation for ChaseMpiDLA::heevd()
     //! - It is implemented based on `cuBLAS`'s `xgemm` and cuSOLVER's
     //! `cusolverXsy(he)evd`.
@@ -837,6 +880,9 @@ public:
     //! ChaseMpiDLA::hhQR().
     //! - This function contains nothing in this class.
     void hhQR(std::size_t locked) override {}
+    //! This function is not used by ChaseMpiDLA, which implements
+    //! ChaseMpiDLA::tsQR() itself.
+    void tsQR(std::size_t locked) override {}
     //! - All required operations for this function has been done in for
     //! ChaseMpiDLA::cholQR().
     //! - This function contains nothing in this class.
@@ -855,6 +901,7 @@ public:
     //! ChaseMpiDLA::Swap().
     //! - This function contains nothing in this class.
     void Swap(std::size_t i, std::size_t j) override {}
+    void Permute(const std::vector<std::size_t>& perm) override {}
     //! - All required operations for this function has been done in for
     //! ChaseMpiDLA::LanczosDos().
     //! - This function contains nothing in this class.
@@ -1105,9 +1152,6 @@ private:
         stream1_; //!< CUDA stream for asynchronous exectution of kernels
     cudaStream_t
         stream2_; //!< CUDA stream for asynchronous exectution of kernels
-    // curandState* states_ = NULL; //!< a pointer of `curandState` for the
-    // cuRAND
-    curandStatePhilox4_32_10_t* states_ = NULL;
     T* d_work_ =
         NULL; //!< a pointer to a local buffer on GPU, which is reserved for the
               //!< extra buffer required for any cuSOLVER routines
@@ -1129,6 +1173,8 @@ private:
     Matrix<Base<T>> Ritzv__;
     Matrix<Base<T>> Resid__;
     Matrix<T> vv__;
+    std::unique_ptr<Matrix<T>> W__; //!< a matrix of size `n_*(nev_+nex_)` on
+                                    //!< GPU, allocated on first use by RRResd()
 
     T* d_ritzVc_ = nullptr;
     Base<T>* d_sum_;
@@ -1,5 +1,9 @@
 #pragma once
+#include <algorithm>
+#include <cstring>
 #include <map>
+#include <memory>
+#include <vector>
 #if defined(HAS_NCCL)
 #include <cuda.h>
 #include <cuda_runtime.h>
@@ -7,6 +11,9 @@
 #endif
 #include <mpi.h>
 
+#include "algorithm/communication.hpp"
+#include "algorithm/trace.hpp"
+
 namespace chase
 {
 namespace mpi
@@ -15,6 +22,7 @@ namespace mpi
 #if defined(HAS_NCCL)
 #define NCCL_BACKEND 1
 #endif
+#define HIER_BACKEND 2
 
 #define CPY_H2H 0
 #define CPY_D2D 1
@@ -35,6 +43,215 @@ typedef MPI_Datatype datatype_2;
 typedef MPI_Comm comm_2;
 #endif
 
+//! @brief Node-aware collectives over an MPI communicator.
+/*!
+  The ranks of the communicator are split into the ranks sharing a node,
+  which exchange their data through an MPI shared-memory window, and the
+  leaders of the nodes (the lowest rank of each node), which are the only
+  ones communicating over the network:
+  - allreduce(): each rank copies its data into the window, the ranks of a
+  node reduce disjoint parts of it with `MPI_Reduce_local`, the leaders
+  allreduce the partial result across the nodes, and each rank copies the
+  final result out of the window.
+  - bcast(): the root copies its data into the window, the leaders broadcast
+  it across the nodes, and each rank copies it out of the window.
+  All the ranks thus receive the same bits, with a single message per node
+  crossing the network.
+*/
+class HierarchicalComm
+{
+public:
+    //! Splits `comm` into its nodes, it is collective over `comm`.
+    explicit HierarchicalComm(MPI_Comm comm)
+    {
+        int rank, nprocs;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &nprocs);
+        MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                            &node_);
+        MPI_Comm_rank(node_, &node_rank_);
+        MPI_Comm_size(node_, &node_size_);
+        MPI_Comm_split(comm, node_rank_ == 0 ? 0 : MPI_UNDEFINED, rank,
+                       &leaders_);
+
+        // the rank within `leaders_` of the leader of each rank
+        int leader = 0;
+        if (leaders_ != MPI_COMM_NULL)
+        {
+            MPI_Comm_rank(leaders_, &leader);
+            MPI_Comm_size(leaders_, &nodes_);
+        }
+        MPI_Bcast(&leader, 1, MPI_INT, 0, node_);
+        MPI_Bcast(&nodes_, 1, MPI_INT, 0, node_);
+        leader_of_.resize(nprocs);
+        MPI_Allgather(&leader, 1, MPI_INT, leader_of_.data(), 1, MPI_INT, comm);
+        rank_ = rank;
+
+        int max_node_size;
+        MPI_Allreduce(&node_size_, &max_node_size, 1, MPI_INT, MPI_MAX, comm);
+        enabled_ = max_node_size > 1;
+    }
+
+    HierarchicalComm(const HierarchicalComm&) = delete;
+
+    //! The communicators and the window are released by free(), which is
+    //! collective, rather than by the destructor: the destructors of the
+    //! ranks of a node may run in different orders.
+    ~HierarchicalComm() = default;
+
+    //! Releases the window and the communicators, it is collective over the
+    //! communicator and must be called in the same order on all its ranks.
+    //! The collectives are not available afterwards.
+    void free()
+    {
+        if (node_ == MPI_COMM_NULL)
+        {
+            return;
+        }
+        if (win_ != MPI_WIN_NULL)
+        {
+            MPI_Win_unlock_all(win_);
+            MPI_Win_free(&win_);
+        }
+        if (leaders_ != MPI_COMM_NULL)
+        {
+            MPI_Comm_free(&leaders_);
+        }
+        MPI_Comm_free(&node_);
+    }
+
+    //! \return `false` once free() has been called.
+    bool active() const { return node_ != MPI_COMM_NULL; }
+
+    //! \return `false` if each node holds a single rank of the
+    //! communicator, such that there is nothing to gain over plain MPI.
+    bool enabled() const { return enabled_; }
+
+    //! The same as `MPI_Allreduce(send, recv, count, datatype, op, comm)`,
+    //! `send` can be `MPI_IN_PLACE`.
+    void allreduce(const void* send, void* recv, int count,
+                   MPI_Datatype datatype, MPI_Op op)
+    {
+        int size;
+        MPI_Type_size(datatype, &size);
+        std::size_t bytes = std::size_t(count) * size;
+        reserve(bytes);
+
+        char* result = next_result();
+        std::memcpy(contribution(node_rank_),
+                    send == MPI_IN_PLACE ? recv : send, bytes);
+        sync();
+
+        std::size_t lo = std::size_t(count) * node_rank_ / node_size_;
+        std::size_t hi = std::size_t(count) * (node_rank_ + 1) / node_size_;
+        if (hi > lo)
+        {
+            std::memcpy(result + lo * size, contribution(0) + lo * size,
+                        (hi - lo) * size);
+            for (int s = 1; s < node_size_; s++)
+            {
+                MPI_Reduce_local(contribution(s) + lo * size,
+                                 result + lo * size, int(hi - lo), datatype,
+                                 op);
+            }
+        }
+        sync();
+
+        if (leaders_ != MPI_COMM_NULL && nodes_ > 1)
+        {
+            MPI_Allreduce(MPI_IN_PLACE, result, count, datatype, op, leaders_);
+        }
+        sync();
+        std::memcpy(recv, result, bytes);
+    }
+
+    //! The same as `MPI_Bcast(buf, count, datatype, root, comm)`.
+    void bcast(void* buf, int count, MPI_Datatype datatype, int root)
+    {
+        int size;
+        MPI_Type_size(datatype, &size);
+        std::size_t bytes = std::size_t(count) * size;
+        reserve(bytes);
+
+        char* result = next_result();
+        if (rank_ == root)
+        {
+            std::memcpy(result, buf, bytes);
+        }
+        sync();
+
+        if (leaders_ != MPI_COMM_NULL && nodes_ > 1)
+        {
+            MPI_Bcast(result, count, datatype, leader_of_[root], leaders_);
+        }
+        sync();
+        if (rank_ != root)
+        {
+            std::memcpy(buf, result, bytes);
+        }
+    }
+
+private:
+    //! Grows the window to slots of at least `bytes`, the window is
+    //! allocated by the first call even for no bytes. It is collective over
+    //! the node, which is safe since all the ranks of a collective pass the
+    //! same count.
+    void reserve(std::size_t bytes)
+    {
+        if (win_ != MPI_WIN_NULL && bytes <= slot_)
+        {
+            return;
+        }
+        if (win_ != MPI_WIN_NULL)
+        {
+            MPI_Win_unlock_all(win_);
+            MPI_Win_free(&win_);
+        }
+        // cache-line aligned slots, with room to grow
+        slot_ = (std::max({bytes, 2 * slot_, std::size_t(1)}) + 63) / 64 * 64;
+
+        // two result slots, followed by the contribution of each rank
+        MPI_Aint total = node_rank_ == 0 ? (node_size_ + 2) * slot_ : 0;
+        MPI_Win_allocate_shared(total, 1, MPI_INFO_NULL, node_, &base_, &win_);
+        MPI_Aint seg;
+        int disp;
+        MPI_Win_shared_query(win_, 0, &seg, &disp, &base_);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
+    }
+
+    //! Makes the stores of each rank of the node visible to the others.
+    void sync()
+    {
+        MPI_Win_sync(win_);
+        MPI_Barrier(node_);
+        MPI_Win_sync(win_);
+    }
+
+    //! The result slots alternate between two calls, such that a rank can
+    //! start the next call while the others still read the last result.
+    char* next_result()
+    {
+        parity_ ^= 1;
+        return base_ + parity_ * slot_;
+    }
+
+    char* contribution(int r) { return base_ + (r + 2) * slot_; }
+
+    MPI_Comm node_ = MPI_COMM_NULL;     //!< the ranks sharing a node
+    MPI_Comm leaders_ = MPI_COMM_NULL;  //!< the leaders of all the nodes
+    int rank_;                          //!< rank within the communicator
+    int node_rank_;                     //!< rank within `node_`
+    int node_size_;                     //!< number of ranks within `node_`
+    int nodes_ = 0;                     //!< number of nodes
+    bool enabled_;                      //!< if any node holds several ranks
+    std::vector<int> leader_of_;        //!< rank in `leaders_` of the leader
+                                        //!< of each rank
+    MPI_Win win_ = MPI_WIN_NULL;        //!< the shared-memory window
+    char* base_ = nullptr;              //!< the window, as seen by this rank
+    std::size_t slot_ = 0;              //!< the size of a slot in bytes
+    int parity_ = 0;                    //!< the last used result slot
+};
+
 class Comm
 {
 public:
@@ -69,6 +286,50 @@ public:
 
     comm_2 get_comm(comm_1 key) { return comm_map_.at(key); }
 
+    //! Enables the HIER_BACKEND for `mpi_comm`, which is left to plain MPI
+    //! if it has at most one rank per node. It is collective over
+    //! `mpi_comm`.
+    void add_hierarchical(comm_1 mpi_comm)
+    {
+        auto hier = std::make_shared<HierarchicalComm>(mpi_comm);
+        if (hier->enabled())
+        {
+            hier_map_[mpi_comm] = hier;
+        }
+    }
+
+    //! Releases the node-aware collectives of `mpi_comm`, if any, it is
+    //! collective over `mpi_comm`. The owner of the communicators calls it
+    //! for each of them in a fixed order, since the copies of this object
+    //! share the collectives and are destroyed in any order.
+    void free_hierarchical(comm_1 mpi_comm)
+    {
+        auto it = hier_map_.find(mpi_comm);
+        if (it != hier_map_.end())
+        {
+            it->second->free();
+            hier_map_.erase(it);
+        }
+    }
+
+    //! \return `nullptr` if `mpi_comm` has no node-aware collectives, or if
+    //! they have been released through another copy of this object.
+    HierarchicalComm* get_hierarchical(comm_1 mpi_comm)
+    {
+        auto it = hier_map_.find(mpi_comm);
+        return it == hier_map_.end() || !it->second->active()
+                   ? nullptr
+                   : it->second.get();
+    }
+
+    //! \return `true` if any communicator has node-aware collectives.
+    bool is_hierarchical() const
+    {
+        return std::any_of(
+            hier_map_.begin(), hier_map_.end(),
+            [](const auto& hier) { return hier.second->active(); });
+    }
+
     Op_2 get_Op(MPI_Op op) { return opt_map_.at(op); }
 
     datatype_2 get_datatype(MPI_Datatype type)
@@ -80,14 +341,17 @@ private:
     std::map<comm_1, comm_2> comm_map_;
     std::map<Op_1, Op_2> opt_map_;
     std::map<datatype_1, datatype_2> datatype_map_;
+    std::map<comm_1, std::shared_ptr<HierarchicalComm>> hier_map_;
 };
 
 typedef Comm Comm_t;
 
 template <typename T>
 void AllReduce(int backend, T* send_data, T* recv_data, int count,
-               MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, Comm_t env)
+               MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, Comm_t& env)
 {
+    ChaseTracer::Scope trace("AllReduce", "mpi", count * sizeof(T));
+    ChaseCommStats::Scope comm_stats(count * sizeof(T));
     switch (backend)
     {
 #if defined(HAS_NCCL)
@@ -98,6 +362,13 @@ void AllReduce(int backend, T* send_data, T* recv_data, int count,
                           env.get_comm(comm), NULL);
             break;
 #endif
+        case HIER_BACKEND:
+            if (auto hier = env.get_hierarchical(comm))
+            {
+                hier->allreduce(send_data, recv_data, count, datatype, op);
+                break;
+            }
+            // falls through
         case MPI_BACKEND:
             MPI_Allreduce(send_data, recv_data, count, datatype, op, comm);
             break;
@@ -106,8 +377,10 @@ void AllReduce(int backend, T* send_data, T* recv_data, int count,
 
 template <typename T>
 void AllReduce(int backend, T* data, int count, MPI_Datatype datatype,
-               MPI_Op op, MPI_Comm comm, Comm_t env)
+               MPI_Op op, MPI_Comm comm, Comm_t& env)
 {
+    ChaseTracer::Scope trace("AllReduce", "mpi", count * sizeof(T));
+    ChaseCommStats::Scope comm_stats(count * sizeof(T));
     switch (backend)
     {
 #if defined(HAS_NCCL)
@@ -117,6 +390,13 @@ void AllReduce(int backend, T* data, int count, MPI_Datatype datatype,
                           env.get_comm(comm), NULL);
             break;
 #endif
+        case HIER_BACKEND:
+            if (auto hier = env.get_hierarchical(comm))
+            {
+                hier->allreduce(MPI_IN_PLACE, data, count, datatype, op);
+                break;
+            }
+            // falls through
         case MPI_BACKEND:
             MPI_Allreduce(MPI_IN_PLACE, data, count, datatype, op, comm);
             break;
@@ -125,8 +405,10 @@ void AllReduce(int backend, T* data, int count, MPI_Datatype datatype,
 
 template <typename T>
 void Bcast(int backend, T* buff, int count, MPI_Datatype datatype, int root,
-           MPI_Comm comm, Comm_t env)
+           MPI_Comm comm, Comm_t& env)
 {
+    ChaseTracer::Scope trace("Bcast", "mpi", count * sizeof(T));
+    ChaseCommStats::Scope comm_stats(count * sizeof(T));
     switch (backend)
     {
 #if defined(HAS_NCCL)
@@ -136,12 +418,66 @@ void Bcast(int backend, T* buff, int count, MPI_Datatype datatype, int root,
                       NULL);
             break;
 #endif
+        case HIER_BACKEND:
+            if (auto hier = env.get_hierarchical(comm))
+            {
+                hier->bcast(buff, count, datatype, root);
+                break;
+            }
+            // falls through
         case MPI_BACKEND:
             MPI_Bcast(buff, count, datatype, root, comm);
             break;
     }
 }
 
+//! Copies the `uplo` (`'U'` or `'L'`) triangle of the `n x n` matrix `a`
+//! with leading dimension `lda` column by column into `packed`, which holds
+//! `n * (n + 1) / 2` elements.
+template <typename T>
+void PackTriangle(char uplo, std::size_t n, const T* a, std::size_t lda,
+                  T* packed)
+{
+    for (std::size_t j = 0; j < n; j++)
+    {
+        std::size_t lo = uplo == 'U' ? 0 : j;
+        std::size_t len = uplo == 'U' ? j + 1 : n - j;
+        std::memcpy(packed, a + lo + j * lda, len * sizeof(T));
+        packed += len;
+    }
+}
+
+//! The inverse of PackTriangle(), the other triangle of `a` is not touched.
+template <typename T>
+void UnpackTriangle(char uplo, std::size_t n, const T* packed, T* a,
+                    std::size_t lda)
+{
+    for (std::size_t j = 0; j < n; j++)
+    {
+        std::size_t lo = uplo == 'U' ? 0 : j;
+        std::size_t len = uplo == 'U' ? j + 1 : n - j;
+        std::memcpy(a + lo + j * lda, packed, len * sizeof(T));
+        packed += len;
+    }
+}
+
+//! AllReduce of the `uplo` triangle of the `n x n` Hermitian matrix `a` with
+//! leading dimension `lda`, which is packed into `buf` of `n * (n + 1) / 2`
+//! elements around the reduction. It halves the volume of the reduction of a
+//! full matrix, the other triangle of `a` is left unreduced. The matrix and
+//! the buffer must be in host memory.
+template <typename T>
+void AllReduceTriangle(int backend, char uplo, std::size_t n, T* a,
+                       std::size_t lda, T* buf, MPI_Datatype datatype,
+                       MPI_Op op, MPI_Comm comm, Comm_t& env)
+{
+    ChaseTracer::Scope trace("AllReduceTriangle", "mpi");
+    PackTriangle(uplo, n, a, lda, buf);
+    AllReduce(backend, buf, static_cast<int>(n * (n + 1) / 2), datatype, op,
+              comm, env);
+    UnpackTriangle(uplo, n, buf, a, lda);
+}
+
 void Memcpy(int mode, void* dst, const void* src, std::size_t count)
 {
     switch (mode)
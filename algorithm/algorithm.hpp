@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <iomanip>
+#include <numeric>
 #include <random>
 
 #include "interface.hpp"
@@ -61,6 +62,29 @@ public:
     static std::size_t lanczos(Chase<T>* kernel, int N, int numvec, int m,
                                int nevex, Base<T>* upperb, bool mode,
                                Base<T>* ritzv_);
+    //! Chebyshev filter of the folded spectrum `(H-center)^2`, which
+    //! amplifies the eigenvalues closest to `center`, see
+    //! ChaseConfig::SetInterval()
+    static std::size_t interval_filter(Chase<T>* kernel, std::size_t n,
+                                       std::size_t unprocessed,
+                                       std::size_t deg, std::size_t* degrees,
+                                       Base<T> center, Base<T> inner,
+                                       Base<T> outer);
+    //! Lanczos estimate of the bounds of the folded spectrum around the
+    //! center of the interval of ChaseConfig::SetInterval()
+    static void interval_lanczos(Chase<T>* kernel, int N, int numvec, int m,
+                                 int nevex, Base<T>* inner, Base<T>* outer,
+                                 bool mode, Base<T>* ritzv_);
+    //! The fraction of the eigenvalues below `x` given by the density of
+    //! states estimated by `numvec` Lanczos procedures of `m` steps, with
+    //! Ritz values `Theta` and weights `Tau`
+    static double dos(double x, const Base<T>* Theta, const Base<T>* Tau,
+                      int numvec, int m);
+    //! The fraction of the eigenvalues below `x` as dos(), with the weight
+    //! of each Ritz value spread between its neighbours instead of a step,
+    //! which resolves the counts in the interior of the spectrum
+    static double dos_spread(double x, const Base<T>* Theta,
+                             const Base<T>* Tau, int numvec, int m);
 };
 
 template <typename T>
@@ -0,0 +1,110 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#ifndef CHASE_ALGORITHM_COMMUNICATION_HPP
+#define CHASE_ALGORITHM_COMMUNICATION_HPP
+
+#include <chrono>
+#include <vector>
+
+namespace chase
+{
+//! Counts the communication of ChASE per phase of the algorithm.
+/*! For each phase, it counts the number of collectives, the bytes of their
+    buffers on this rank, and the wall-clock time spent in them, from the
+    posting of a collective until its completion. The counters are
+    process-wide, such that the collectives of mpi_wrapper.hpp and of
+    ChaseMpiDLA can record into them without access to the solver.
+
+    The phases are the indices of ChasePerfData<T>::TimePtrs, the current
+    phase is set by ChasePerfData when it starts and ends a timer, and the
+    communication outside of all the phases of an iteration is attributed
+    to the index `0` (ChasePerfData<T>::TimePtrs::All). The time of the
+    asynchronous collectives of the NCCL backend only covers their
+    enqueueing.
+ */
+class ChaseCommStats
+{
+public:
+    //! The number of phases, as in ChasePerfData<T>::TimePtrs.
+    static constexpr int nphases = 7;
+
+    struct Counter
+    {
+        std::size_t calls = 0; //!< number of collectives
+        std::size_t bytes = 0; //!< bytes sent or received by this rank
+        double time = 0;       //!< seconds spent in the collectives
+    };
+
+    //! Counts the time from its construction to its destruction in the
+    //! current phase, and the collectives passed to count().
+    class Scope
+    {
+    public:
+        //! Starts the timer without any collective.
+        Scope() : begin_(std::chrono::steady_clock::now()) {}
+
+        //! Starts the timer of one collective of `bytes` bytes.
+        explicit Scope(std::size_t bytes) : Scope() { count(bytes); }
+
+        ~Scope()
+        {
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - begin_;
+            ChaseCommStats::get().add(calls_, bytes_, elapsed.count());
+        }
+
+        //! Adds one collective of `bytes` bytes.
+        void count(std::size_t bytes)
+        {
+            calls_++;
+            bytes_ += bytes;
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        std::chrono::steady_clock::time_point begin_;
+        std::size_t calls_ = 0;
+        std::size_t bytes_ = 0;
+    };
+
+    //! Returns the counters of the process.
+    static ChaseCommStats& get()
+    {
+        static ChaseCommStats stats;
+        return stats;
+    }
+
+    //! Attributes the following communication to `phase`.
+    void set_phase(int phase) { phase_ = phase; }
+
+    int get_phase() const { return phase_; }
+
+    void add(std::size_t calls, std::size_t bytes, double time)
+    {
+        counters_[phase_].calls += calls;
+        counters_[phase_].bytes += bytes;
+        counters_[phase_].time += time;
+    }
+
+    //! Sets all the counters to zero.
+    void reset() { counters_.assign(nphases, Counter()); }
+
+    //! The counters, indexed by phase.
+    const std::vector<Counter>& get_counters() const { return counters_; }
+
+private:
+    ChaseCommStats() : counters_(nphases) {}
+
+    int phase_ = 0;
+    std::vector<Counter> counters_;
+};
+
+} // namespace chase
+#endif
@@ -9,9 +9,12 @@
 #define CHASE_ALGORITHM_CONFIGURATION_HPP
 
 #include <complex>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <random>
+#include <string>
+#include <type_traits>
 
 namespace chase
 {
@@ -181,6 +184,10 @@ public:
         lanczos_iter_ =
             chase_config_helper::initLanczosIter<T>(approx_, optimization_);
         tol_ = chase_config_helper::initTolerance<T>(approx_, optimization_);
+        if (const char* file = std::getenv("CHASE_TELEMETRY"))
+        {
+            telemetry_file_ = file;
+        }
     }
 
     //! Returns the value of the `approx_` flag.
@@ -438,6 +445,156 @@ public:
     //! Return the value of `cholqr_`
     bool DoCholQR() { return cholqr_; }
 
+    //! Sets the `tsqr_` flag to either `true` or `false`.
+    /*! This function is used to change the value of `tsqr_` so that the
+        Householder QR, used when CholQR is disabled or fails, is computed
+        either by the communication-avoiding TSQR (`true`) or by the default
+        Householder QR of the backend (`false`), e.g. ScaLAPACK.
+        \param flag A boolean parameter which admits either a `true` or
+       `false` value.
+     */
+    void SetTSQR(bool flag) { tsqr_ = flag; }
+    //! Return the value of `tsqr_`
+    bool UseTSQR() const { return tsqr_; }
+
+    //! Sets the `locked_qr_` flag to either `true` or `false`.
+    /*! This function is used to change the value of `locked_qr_` so that
+        CholQR either orthogonalizes the unconverged vectors against the
+        converged ones and factorizes only the unconverged block (`true`),
+        or factorizes all the `nev+nex` vectors (`false`).
+        \param flag A boolean parameter which admits either a `true` or
+       `false` value.
+     */
+    void SetLockedQR(bool flag) { locked_qr_ = flag; }
+    //! Return the value of `locked_qr_`
+    bool UseLockedQR() const { return locked_qr_; }
+
+    //! Sets the `fused_rr_` flag to either `true` or `false`.
+    /*! This function is used to change the value of `fused_rr_` so
+        that the residuals are either computed together with the
+        Rayleigh-Ritz step (`true`), reusing its product of the matrix
+        with the vectors, or separately (`false`) with an additional
+        matrix-vectors product.
+        \param flag A boolean parameter which admits either a `true` or `false`
+       value.
+     */
+    void SetFusedRR(bool flag) { fused_rr_ = flag; }
+    //! Return the value of `fused_rr_`
+    bool DoFusedRR() { return fused_rr_; }
+
+    //! Sets the `mixed_precision_` flag to either `true` or `false`.
+    /*! When it is `true`, the Chebyshev filter of the first iterations runs
+        in single precision on single-precision copies of the matrix and of
+        the vectors. The filter is switched back to the working precision
+        once the smallest residual of the unconverged eigenpairs reaches
+        GetMixedPrecisionFactor() times GetTol(), or the accuracy achievable
+        in single precision. It has no effect when the scalar type is already
+        in single precision, or when the backend does not support it.
+        \param flag A boolean parameter which admits either a `true` or `false`
+       value.
+     */
+    void SetMixedPrecision(bool flag) { mixed_precision_ = flag; }
+    //! Return the value of `mixed_precision_`
+    bool UseMixedPrecision() { return mixed_precision_; }
+
+    //! Sets the factor of the tolerance below which the filter is switched
+    //! from single precision back to the working precision.
+    /*! \param factor A value larger than *1*.
+     */
+    void SetMixedPrecisionFactor(double factor)
+    {
+        mixed_precision_factor_ = factor;
+    }
+    //! Return the value of `mixed_precision_factor_`
+    double GetMixedPrecisionFactor() const { return mixed_precision_factor_; }
+
+    //! Sets the number of chunks of columns in which each step of the
+    //! Chebyshev filter is split.
+    /*! With more than one chunk, the communication of a chunk is overlapped
+        with the computation of the following ones, at the price of smaller
+        matrix-matrix products. It has no effect without MPI.
+        \param chunks A value larger or equal to *1*.
+     */
+    void SetFilterChunks(std::size_t chunks) { filter_chunks_ = chunks; }
+    //! Return the value of `filter_chunks_`
+    std::size_t GetFilterChunks() const { return filter_chunks_; }
+
+    //! Sets the file to which the state of the solve is written during the
+    //! iterations, and from which it is resumed when DoResume() is `true`.
+    /*! The file is replaced only once a new checkpoint has been completely
+        written, so an interrupted run always leaves a usable one behind.
+        \param file The name of the checkpoint file.
+        \param interval The number of iterations between two checkpoints,
+        no checkpoint is written if it is *0*.
+     */
+    void SetCheckpoint(const std::string& file, std::size_t interval)
+    {
+        checkpoint_file_ = file;
+        checkpoint_interval_ = interval;
+    }
+    //! Return the value of `checkpoint_file_`
+    const std::string& GetCheckpointFile() const { return checkpoint_file_; }
+    //! Return the value of `checkpoint_interval_`
+    std::size_t GetCheckpointInterval() const { return checkpoint_interval_; }
+
+    //! Sets the `resume_` flag to either `true` or `false`.
+    /*! If `true`, the solve starts from the state stored in
+        GetCheckpointFile() instead of from the initial vectors, whenever this
+        file exists and matches the eigenproblem.
+     */
+    void SetResume(bool flag) { resume_ = flag; }
+    //! Return the value of `resume_`
+    bool DoResume() const { return resume_; }
+
+    //! Sets the interval `[lower, upper]` of the spectrum in which the
+    //! eigenpairs are computed.
+    /*! By default, the `nev` lowest eigenpairs are computed. With an
+        interval, the `nev` eigenpairs closest to its center are computed
+        instead, with a Chebyshev filter of the folded spectrum which damps
+        the eigenvalues away from the center. All the eigenvalues of the
+        interval are found if `nev` is at least their number, see
+        chase::mpi::ChaseMpiSlices for an estimate. An empty interval
+        (`lower >= upper`) restores the default.
+        \param lower The lower end of the interval.
+        \param upper The upper end of the interval.
+     */
+    void SetInterval(double lower, double upper)
+    {
+        interval_lower_ = lower;
+        interval_upper_ = upper;
+    }
+    //! Return if an interval has been set by SetInterval()
+    bool UseInterval() const { return interval_lower_ < interval_upper_; }
+    //! Return the value of `interval_lower_`
+    double GetIntervalLower() const { return interval_lower_; }
+    //! Return the value of `interval_upper_`
+    double GetIntervalUpper() const { return interval_upper_; }
+
+    //! Sets the maximum degree of the filter of the interval mode.
+    /*! A degree of the filter of the folded spectrum is an application of
+        \f$(A - cI)^2\f$, with \f$c\f$ the center of the interval, hence
+        two matrix products. The interior eigenvalues are much less
+        separated in the folded spectrum than the extremal ones, such that
+        the degrees are larger than those bounded by GetMaxDeg().
+        \param _maxDeg The maximum degree in \f$(A - cI)^2\f$, *150* by
+        default in double precision and *75* in single precision, where
+        the amplified vectors overflow earlier.
+     */
+    void SetIntervalMaxDeg(std::size_t _maxDeg) { interval_max_deg_ = _maxDeg; }
+    //! Return the value of `interval_max_deg_`
+    std::size_t GetIntervalMaxDeg() const { return interval_max_deg_; }
+
+    //! Sets the file to which a JSON record of each iteration is appended.
+    /*! The records are written by the rank 0 only, see ChaseTelemetry for
+        their content. The default is the value of the environment variable
+        `CHASE_TELEMETRY`, such that the telemetry of an application can be
+        enabled without recompiling it. An empty name disables it.
+        \param file The name of the telemetry file.
+     */
+    void SetTelemetryFile(const std::string& file) { telemetry_file_ = file; }
+    //! Return the value of `telemetry_file_`
+    const std::string& GetTelemetryFile() const { return telemetry_file_; }
+
     void EnableSymCheck(bool flag) { sym_check_ = flag; }
     bool DoSymCheck() { return sym_check_; }
 
@@ -560,6 +717,58 @@ private:
     //! Optional parameter indicating if CholeksyQR is disabled
     bool cholqr_ = true;
 
+    //! Optional parameter indicating if the Householder QR is computed by TSQR
+    bool tsqr_ = false;
+
+    //! Optional parameter indicating if CholQR skips the converged vectors
+    bool locked_qr_ = false;
+
+    //! Optional parameter indicating if the residuals are computed within the
+    //! Rayleigh-Ritz step
+    bool fused_rr_ = true;
+
+    //! Optional parameter indicating if the filter of the first iterations
+    //! runs in single precision
+    bool mixed_precision_ = false;
+
+    //! Optional parameter indicating the factor of the tolerance below which
+    //! the filter switches back from single precision
+    double mixed_precision_factor_ = 1e3;
+
+    //! Optional parameter indicating the number of chunks of columns in which
+    //! each step of the filter is split
+    std::size_t filter_chunks_ = 1;
+
+    //! Optional parameter indicating the file of the checkpoints
+    std::string checkpoint_file_ = "chase.ckpt";
+
+    //! Optional parameter indicating the number of iterations between two
+    //! checkpoints, *0* disables them
+    std::size_t checkpoint_interval_ = 0;
+
+    //! Optional parameter indicating if the solve resumes from a checkpoint
+    bool resume_ = false;
+
+    //! Optional parameter indicating the lower end of the interval of the
+    //! computed eigenpairs, no interval if it is not below `interval_upper_`
+    double interval_lower_ = 0;
+
+    //! Optional parameter indicating the upper end of the interval of the
+    //! computed eigenpairs
+    double interval_upper_ = 0;
+
+    //! Optional parameter indicating the maximum degree of the filter of the
+    //! interval mode, in applications of the squared shifted matrix
+    std::size_t interval_max_deg_ =
+        std::is_same<T, float>::value ||
+                std::is_same<T, std::complex<float>>::value
+            ? 75
+            : 150;
+
+    //! Optional parameter indicating the file of the per-iteration
+    //! telemetry, none if it is empty
+    std::string telemetry_file_;
+
     bool sym_check_ = true;
 };
 
@@ -8,12 +8,34 @@
 #ifndef CHASE_ALGORITHM_INTERFACE_HPP
 #define CHASE_ALGORITHM_INTERFACE_HPP
 
+#include <vector>
+
 #include "configuration.hpp"
+#include "telemetry.hpp"
 #include "types.hpp"
+#include "workspace.hpp"
 
 namespace chase
 {
 
+//! The state of an in-flight solve, besides the vectors, which is needed to
+//! resume it.
+template <class T>
+struct ChaseState
+{
+    std::size_t iteration = 0; //!< number of completed iterations
+    std::size_t locked = 0;    //!< number of converged eigenpairs
+    Base<T> lowerb = 0;        //!< lower bound of the filtered interval
+    Base<T> upperb = 0;        //!< upper bound of the spectrum
+    Base<T> lambda = 0;        //!< estimate of the lowest eigenvalue
+    bool interval = false;     //!< if the solve is in the interval mode
+    Base<T> center = 0;        //!< center of the interval, if any
+    std::vector<Base<T>> ritzv;     //!< the `nev+nex` Ritz values
+    std::vector<Base<T>> resid;     //!< their residuals
+    std::vector<Base<T>> residLast; //!< their residuals of the iteration before
+    std::vector<std::size_t> degrees; //!< their filter degrees
+};
+
 template <class T>
 class Chase
 {
@@ -36,6 +58,15 @@ public:
         @param offset: the offset of column which the `HEMM` starts from.
     */
     virtual void HEMM(std::size_t nev, T alpha, T beta, std::size_t offset) = 0;
+    //! This member function switches the following `HEMM` operations to
+    //! single precision, on single-precision copies of the matrix and of the
+    //! non-converged vectors.
+    //! \return `false` if it is not supported, in which case `HEMM` keeps
+    //! running in the working precision.
+    virtual bool EnterSinglePrecision() = 0;
+    //! This member function copies the vectors filtered in single precision
+    //! back and switches `HEMM` to the working precision.
+    virtual void LeaveSinglePrecision() = 0;
     //! This member function performs a QR factorization with an explicit
     //! construction of the unitary matrix `Q`.
     //!
@@ -81,6 +112,11 @@ public:
     //! @param i: one of the column index to be swapped
     //! @param j: another of the column index to be swapped
     virtual void Swap(std::size_t i, std::size_t j) = 0;
+    //! This function reorders all the columns of the matrices used in the
+    //! Chebyschev filter at once
+    //! @param perm: a permutation of `0, ..., nev+nex-1`, the column `k`
+    //! receives the former column `perm[k]`
+    virtual void Permute(const std::vector<std::size_t>& perm) = 0;
     //! It locks the `new_converged` eigenvectors, which makes `locked_ +=
     //! new_converged`.
     //! @param new_converged: number of newly converged eigenpairs in the
@@ -113,6 +149,24 @@ public:
     virtual Base<T>* GetRitzv() = 0;
     //! Return the residuals of computed ritz pairs
     virtual Base<T>* GetResid() = 0;
+    //! Return the number of eigenpairs which converged within the tolerance,
+    //! below `GetNev()` if the last solve stopped at
+    //! ChaseConfig::GetMaxIter()
+    virtual std::size_t GetNconv() = 0;
+    //! Return the pool of buffers for the temporaries of the solver
+    virtual Workspace& GetWorkspace() = 0;
+    //! Writes `state` and the current vectors to
+    //! ChaseConfig::GetCheckpointFile(). The write may complete in the
+    //! background, at the latest when the next one starts or in End().
+    virtual void Checkpoint(const ChaseState<T>& state) = 0;
+    //! Reads `state` and the vectors back from
+    //! ChaseConfig::GetCheckpointFile(). The interval mode and center of
+    //! `state` on input are those of the solve to resume.
+    //! \return `false` if there is no checkpoint for this eigenproblem.
+    virtual bool Resume(ChaseState<T>& state) = 0;
+    //! Return the sink of the per-iteration records, `nullptr` if the
+    //! telemetry is disabled or on the ranks which do not write it.
+    virtual ChaseTelemetry* GetTelemetry() = 0;
     //! Return a class which contains the configuration parameters
     virtual ChaseConfig<T>& GetConfig() = 0;
     //! Return the number of MPI procs used, it is `1` when sequential ChASE is
@@ -16,7 +16,9 @@
 #include <iostream>
 #include <vector>
 
+#include "communication.hpp"
 #include "interface.hpp"
+#include "trace.hpp"
 #include "types.hpp"
 
 namespace chase
@@ -28,6 +30,7 @@ namespace chase
     - Number of filtered vectors
     - Timings of each main algorithmic procedure (Lanczos, Filter, etc.)
     - Number of FLOPs executed
+    - Communication of each main algorithmic procedure, see ChaseCommStats
 
     The number of iterations and filtered vectors can be used to
     monitor the behavior of the algorithm as it attempts to converge
@@ -76,6 +79,8 @@ public:
 
         std::fill(timings.begin(), timings.end(),
                   std::chrono::duration<double>());
+        ChaseCommStats::get().reset();
+        comm_counters.clear();
     }
 
     //! Returns the number of total subspace iterations executed by ChASE.
@@ -110,7 +115,20 @@ public:
      */
     std::size_t get_filtered_vecs() { return chase_filtered_vecs; }
 
-    std::vector<std::chrono::duration<double>> get_timings() { return timings; }
+    std::vector<std::chrono::duration<double>> get_timings()
+    {
+        this->calculateTimings();
+        return timings;
+    }
+
+    //! Returns the communication counters of each procedure, indexed as
+    //! the timings, in which the index of `All` holds the communication
+    //! outside of the other procedures. They are collected when the timer
+    //! of `All` ends.
+    std::vector<ChaseCommStats::Counter> get_comm_counters()
+    {
+        return comm_counters;
+    }
 
     //! Returns the total number of FLOPs executed by ChASE.
     /*! When measuring performance, it is fundamental to understand how
@@ -218,11 +236,17 @@ public:
     void start_clock(TimePtrs t)
     {
         start_points[t].push_back(getTimePoint());
+        ChaseCommStats::get().set_phase(t);
     }
 
     void end_clock(TimePtrs t)
     {
         end_points[t].push_back(getTimePoint());
+        ChaseCommStats::get().set_phase(All);
+        if (t == All)
+        {
+            comm_counters = ChaseCommStats::get().get_counters();
+        }
     }
 
     inline auto getTimePoint() -> TimePointType
@@ -254,6 +278,11 @@ public:
 
         When the parameter `N` is set to be a number else than zero, the
         function returns total FLOPs and filter FLOPs, respectively.
+
+        If any communication was counted, a second table reports for each
+        section the number of collectives, the megabytes of their buffers
+        and the seconds spent in them, the column `Other` holding the
+        communication outside of the sections.
         \param N Control parameter. By default equal to *0*.
      */
     void print(std::size_t N = 0)
@@ -293,8 +322,70 @@ public:
 
         printTable(output_names, 
                    all_values);
+        printCommTable();
     }
 
+#ifndef NO_MPI
+    //! Collective summary of the timings over the ranks of `comm`
+    /*! The timing of each of the sections of print() is reduced over the
+        ranks of `comm` and rank 0 prints, for each section, the minimum,
+        average and maximum over the ranks, the rank of the maximum, and
+        the imbalance ratio `max / avg`, which is 1 for a perfectly
+        balanced section. It must be called by all the ranks of `comm`.
+        \param comm The communicator of the ranks to summarize.
+     */
+    void print_summary(MPI_Comm comm)
+    {
+        this->calculateTimings();
+
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+
+        std::size_t n = timings.size();
+        std::vector<double> local(n), min(n), sum(n);
+        // the layout of MPI_DOUBLE_INT
+        struct ValueRank
+        {
+            double value;
+            int rank;
+        };
+        std::vector<ValueRank> in(n), max(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            local[i] = timings[i].count();
+            in[i].value = local[i];
+            in[i].rank = rank;
+        }
+        MPI_Allreduce(local.data(), min.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+        MPI_Allreduce(local.data(), sum.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+        MPI_Allreduce(in.data(), max.data(), n, MPI_DOUBLE_INT, MPI_MAXLOC,
+                      comm);
+
+        if (rank != 0)
+        {
+            return;
+        }
+
+        std::vector<std::string> names = {"All", "Init Vecs", "Lanczos",
+                                          "Filter", "QR", "RR", "Resid"};
+        std::cout << "| Section   |       min |       avg |       max | "
+                     "max rank | imbalance |\n";
+        for (std::size_t i = 0; i < n; i++)
+        {
+            double avg = sum[i] / size;
+            std::cout << "| " << std::left << std::setw(9) << names[i]
+                      << std::right << " | " << std::scientific
+                      << std::setprecision(3) << min[i] << " | " << avg
+                      << " | " << max[i].value << " | " << std::setw(8)
+                      << max[i].rank << " | " << std::fixed
+                      << std::setprecision(3) << std::setw(9)
+                      << (avg > 0 ? max[i].value / avg : 1.0) << " |\n";
+        }
+        std::cout << std::defaultfloat;
+    }
+#endif
+
 private:
     inline std::chrono::duration<double> calculatePointTiming(TimePointType &start, TimePointType &stop) 
     {
@@ -312,6 +403,8 @@ private:
 #ifdef HAS_CUDA
         cudaDeviceSynchronize();
 #endif
+        std::fill(timings.begin(), timings.end(),
+                  std::chrono::duration<double>());
         for(size_t it=0; it<start_points.size(); ++it)
         {
             size_t vec_size = start_points[it].size();
@@ -341,6 +434,67 @@ private:
         std::cout << '\n';
 }
 
+    void printCommTable()
+    {
+        std::size_t calls = 0;
+        for (const auto& c : comm_counters)
+        {
+            calls += c.calls;
+        }
+        if (calls == 0)
+        {
+            return;
+        }
+
+        std::vector<std::string> names = {"Comm",   "Init Vecs", "Lanczos",
+                                          "Filter", "QR",        "RR",
+                                          "Resid",  "Other"};
+        std::vector<std::vector<std::string>> rows(
+            3, std::vector<std::string>(names.size()));
+        rows[0][0] = "calls";
+        rows[1][0] = "MB";
+        rows[2][0] = "time";
+        for (std::size_t i = 1; i < names.size(); i++)
+        {
+            // the last column holds the communication outside the sections
+            const auto& c = comm_counters[i % comm_counters.size()];
+            std::ostringstream stream;
+            stream << std::scientific << std::setprecision(3);
+            rows[0][i] = std::to_string(c.calls);
+            stream << c.bytes / 1e6;
+            rows[1][i] = stream.str();
+            stream.str("");
+            stream << c.time;
+            rows[2][i] = stream.str();
+        }
+
+        std::cout << "| ";
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            std::size_t max_width = names[i].size();
+            for (const auto& row : rows)
+            {
+                max_width = std::max(max_width, row[i].size());
+            }
+            std::cout << std::setw(max_width) << names[i] << " | ";
+        }
+        std::cout << '\n';
+        for (const auto& row : rows)
+        {
+            std::cout << "| ";
+            for (std::size_t i = 0; i < names.size(); ++i)
+            {
+                std::size_t max_width = names[i].size();
+                for (const auto& r : rows)
+                {
+                    max_width = std::max(max_width, r[i].size());
+                }
+                std::cout << std::setw(max_width) << row[i] << " | ";
+            }
+            std::cout << '\n';
+        }
+    }
+
     std::size_t chase_iteration_count;
     std::size_t chase_filtered_vecs;
     std::vector<std::size_t> chase_iter_blocksizes;
@@ -348,6 +502,7 @@ private:
     std::vector<std::chrono::duration<double>> timings;
     std::vector<std::vector<TimePointType>> start_points;
     std::vector<std::vector<TimePointType>> end_points;
+    std::vector<ChaseCommStats::Counter> comm_counters;
     int nprocs;
 };
 //! A derived class used to extract performance and configuration data.
@@ -394,12 +549,28 @@ public:
     }
     void HEMM(std::size_t nev, T alpha, T beta, std::size_t offset)
     {
+        ChaseTracer::Scope trace("HEMM", "chase");
         chase_->HEMM(nev, alpha, beta, offset);
         perf_.add_filtered_vecs(nev);
     }
 
+    bool EnterSinglePrecision()
+    {
+        perf_.start_clock(ChasePerfData<T>::TimePtrs::Filter);
+        bool ok = chase_->EnterSinglePrecision();
+        perf_.end_clock(ChasePerfData<T>::TimePtrs::Filter);
+        return ok;
+    }
+    void LeaveSinglePrecision()
+    {
+        perf_.start_clock(ChasePerfData<T>::TimePtrs::Filter);
+        chase_->LeaveSinglePrecision();
+        perf_.end_clock(ChasePerfData<T>::TimePtrs::Filter);
+    }
+
     void QR(std::size_t fixednev, Base<T> cond)
     {
+        ChaseTracer::Scope trace("QR", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Qr);
         chase_->QR(fixednev, cond);
         perf_.end_clock(ChasePerfData<T>::TimePtrs::Qr);
@@ -407,6 +578,7 @@ public:
 
     void RR(Base<T>* ritzv, std::size_t block)
     {
+        ChaseTracer::Scope trace("RR", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Rr);
         chase_->RR(ritzv, block);
         perf_.add_iter_blocksize(block);
@@ -414,13 +586,14 @@ public:
     }
     void Resd(Base<T>* ritzv, Base<T>* resd, std::size_t fixednev)
     {
+        ChaseTracer::Scope trace("Resd", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Resids_Locking);
         chase_->Resd(ritzv, resd, fixednev);
         // We end with ->chase_->Lock()
     }
     void Lanczos(std::size_t m, Base<T>* upperb)
     {
-        std::chrono::duration<double> elapsed;
+        ChaseTracer::Scope trace("Lanczos", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Lanczos);
         chase_->Lanczos(m, upperb);
         perf_.end_clock(ChasePerfData<T>::TimePtrs::Lanczos);
@@ -428,6 +601,7 @@ public:
     void Lanczos(std::size_t M, std::size_t idx, Base<T>* upperb,
                  Base<T>* ritzv, Base<T>* Tau, Base<T>* ritzV)
     {
+        ChaseTracer::Scope trace("Lanczos", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Lanczos);
         chase_->Lanczos(M, idx, upperb, ritzv, Tau, ritzV);
         perf_.end_clock(ChasePerfData<T>::TimePtrs::Lanczos);
@@ -435,12 +609,22 @@ public:
     }
     void LanczosDos(std::size_t idx, std::size_t m, T* ritzVc)
     {
+        ChaseTracer::Scope trace("LanczosDos", "chase");
         perf_.start_clock(ChasePerfData<T>::TimePtrs::Lanczos);
         chase_->LanczosDos(idx, m, ritzVc);
         perf_.end_clock(ChasePerfData<T>::TimePtrs::Lanczos);
     }
 
-    void Swap(std::size_t i, std::size_t j) { chase_->Swap(i, j); }
+    void Swap(std::size_t i, std::size_t j)
+    {
+        ChaseTracer::Scope trace("Swap", "chase");
+        chase_->Swap(i, j);
+    }
+    void Permute(const std::vector<std::size_t>& perm)
+    {
+        ChaseTracer::Scope trace("Permute", "chase");
+        chase_->Permute(perm);
+    }
     void Lock(std::size_t new_converged)
     {
         chase_->Lock(new_converged);
@@ -479,6 +663,11 @@ public:
     std::size_t GetNex() { return chase_->GetNex(); }
     Base<T>* GetRitzv() { return chase_->GetRitzv(); }
     Base<T>* GetResid() { return chase_->GetResid(); }
+    std::size_t GetNconv() { return chase_->GetNconv(); }
+    Workspace& GetWorkspace() { return chase_->GetWorkspace(); }
+    void Checkpoint(const ChaseState<T>& state) { chase_->Checkpoint(state); }
+    bool Resume(ChaseState<T>& state) { return chase_->Resume(state); }
+    ChaseTelemetry* GetTelemetry() { return chase_->GetTelemetry(); }
     ChaseConfig<T>& GetConfig() { return chase_->GetConfig(); }
     ChasePerfData<T>& GetPerfData() { return perf_; }
 
@@ -0,0 +1,139 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#ifndef CHASE_ALGORITHM_RANDOM_HPP
+#define CHASE_ALGORITHM_RANDOM_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace chase
+{
+//! Counter-based generator of normally distributed random numbers.
+/*! The element `(i, j)` of a random matrix is a function of the seed and of
+    its global indices only: the 128 bits counter `(i, j)` is encrypted with
+    the key `seed` by the Philox4x32-10 bijection (Salmon et al., "Parallel
+    random numbers: as easy as 1, 2, 3", SC'11), and two uniform numbers of
+    53 bits are mapped to two normal numbers by the Box-Muller transform.
+    A complex element uses both normal numbers of its counter, two real
+    elements `(2i, j)` and `(2i + 1, j)` share the counter `(i, j)`. Hence
+    the random vectors do not depend on the distribution of the rows
+    over MPI ranks or on the order of the generation, and each block can be
+    filled by any number of threads without state.
+ */
+class ChaseRandom
+{
+public:
+    //! The random matrix of seed `seed`.
+    explicit ChaseRandom(std::uint64_t seed) : seed_(seed) {}
+
+    //! Returns the element `(i, j)` of the random matrix.
+    template <typename T>
+    T normal(std::uint64_t i, std::uint64_t j) const
+    {
+        double z0, z1;
+        if constexpr (std::is_arithmetic<T>::value)
+        {
+            normals(i >> 1, j, z0, z1);
+            return T(i & 1 ? z1 : z0);
+        }
+        else
+        {
+            normals(i, j, z0, z1);
+            return T(z0, z1);
+        }
+    }
+
+    //! Fills the `nrows x ncols` block `V` of leading dimension `ldv` with
+    //! the rows `[row_off, row_off + nrows)` and the columns
+    //! `[col_off, col_off + ncols)` of the random matrix. The columns are
+    //! shared between the OpenMP threads.
+    template <typename T>
+    void fill(std::size_t nrows, std::size_t ncols, T* V, std::size_t ldv,
+              std::size_t row_off, std::size_t col_off = 0) const
+    {
+#pragma omp parallel for schedule(static)
+        for (std::size_t j = 0; j < ncols; j++)
+        {
+            T* v = V + ldv * j;
+            std::size_t i = 0;
+            if constexpr (std::is_arithmetic<T>::value)
+            {
+                // the pairs of rows of a counter, after an odd first row
+                if (row_off % 2 == 1 && nrows > 0)
+                {
+                    v[i] = normal<T>(row_off + i, col_off + j);
+                    i++;
+                }
+                for (; i + 1 < nrows; i += 2)
+                {
+                    double z0, z1;
+                    normals((row_off + i) >> 1, col_off + j, z0, z1);
+                    v[i] = T(z0);
+                    v[i + 1] = T(z1);
+                }
+            }
+            for (; i < nrows; i++)
+            {
+                v[i] = normal<T>(row_off + i, col_off + j);
+            }
+        }
+    }
+
+private:
+    void normals(std::uint64_t i, std::uint64_t j, double& z0,
+                 double& z1) const
+    {
+        std::uint32_t x[4] = {
+            static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32),
+            static_cast<std::uint32_t>(j), static_cast<std::uint32_t>(j >> 32)};
+        philox(x);
+
+        // u1 in (0, 1) for the logarithm, u2 in [0, 1)
+        const double ulp = 1.0 / 9007199254740992.0; // 2^-53
+        double u1 =
+            ((static_cast<std::uint64_t>(x[0]) << 21 ^ x[1] >> 11) + 0.5) * ulp;
+        double u2 = (static_cast<std::uint64_t>(x[2]) << 21 ^ x[3] >> 11) * ulp;
+
+        const double two_pi = 6.283185307179586;
+        double r = std::sqrt(-2.0 * std::log(u1));
+        z0 = r * std::cos(two_pi * u2);
+        z1 = r * std::sin(two_pi * u2);
+    }
+
+    //! The 10 rounds of Philox4x32 on the counter `x` with the key `seed_`.
+    void philox(std::uint32_t x[4]) const
+    {
+        const std::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        const std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+        std::uint32_t k0 = static_cast<std::uint32_t>(seed_);
+        std::uint32_t k1 = static_cast<std::uint32_t>(seed_ >> 32);
+        for (int r = 0; r < 10; r++)
+        {
+            std::uint64_t p0 = M0 * x[0];
+            std::uint64_t p1 = M1 * x[2];
+            std::uint32_t y0 = static_cast<std::uint32_t>(p1 >> 32) ^ x[1] ^ k0;
+            std::uint32_t y1 = static_cast<std::uint32_t>(p1);
+            std::uint32_t y2 = static_cast<std::uint32_t>(p0 >> 32) ^ x[3] ^ k1;
+            std::uint32_t y3 = static_cast<std::uint32_t>(p0);
+            x[0] = y0;
+            x[1] = y1;
+            x[2] = y2;
+            x[3] = y3;
+            k0 += W0;
+            k1 += W1;
+        }
+    }
+
+    std::uint64_t seed_;
+};
+
+} // namespace chase
+#endif
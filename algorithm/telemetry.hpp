@@ -0,0 +1,184 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#ifndef CHASE_ALGORITHM_TELEMETRY_HPP
+#define CHASE_ALGORITHM_TELEMETRY_HPP
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace chase
+{
+//! Writes one JSON record per subspace iteration to a file.
+/*! The file is opened in append mode and holds one JSON object per line
+    (JSON Lines), such that the records of many solves can be collected in
+    the same file and processed line by line. A record is opened by
+    begin(), filled by add() and the phase timers start() and stop(), and
+    written by end(). Its fields are, in the order they are added:
+    - `solve` and `iteration`, the index of the solve since the file was
+    opened and of the iteration within the solve,
+    - the fields added by Algorithm<T>::solve() and by the implementation of
+    Chase<T>::QR(), e.g. the spectral bounds, the number of unconverged and
+    newly converged eigenpairs, the histogram of the filter degrees, the QR
+    variant and the estimated condition number,
+    - `time`, the wall-clock time in seconds of each phase of the iteration.
+
+    The record is flushed when it is written, so the file is complete up to
+    the last iteration even if the solve is aborted.
+    \see ChaseConfig::SetTelemetryFile()
+ */
+class ChaseTelemetry
+{
+public:
+    //! Opens `file` for appending.
+    explicit ChaseTelemetry(const std::string& file)
+        : file_(file), out_(file, std::ios::app)
+    {
+    }
+
+    //! Return the name of the file
+    const std::string& file() const { return file_; }
+
+    //! Starts the records of a new solve.
+    void start_solve()
+    {
+        solve_++;
+        iteration_ = 0;
+    }
+
+    //! Opens the record of `iteration`, the fields of the previous one are
+    //! discarded if it was not written.
+    void begin(std::size_t iteration)
+    {
+        iteration_ = iteration;
+        record_.str("");
+        times_.clear();
+        add("solve", solve_);
+        add("iteration", iteration_);
+    }
+
+    //! Adds a numerical field, a non-finite value is written as `null`.
+    void add(const std::string& key, double value)
+    {
+        field(key);
+        if (std::isfinite(value))
+        {
+            record_ << std::setprecision(std::numeric_limits<double>::digits10 +
+                                         1)
+                    << value;
+        }
+        else
+        {
+            record_ << "null";
+        }
+    }
+
+    //! Adds an integer field.
+    void add(const std::string& key, std::size_t value)
+    {
+        field(key);
+        record_ << value;
+    }
+
+    //! Adds a string field.
+    void add(const std::string& key, const std::string& value)
+    {
+        field(key);
+        record_ << '"' << value << '"';
+    }
+
+    //! Adds the histogram of the `n` values as an object mapping each value
+    //! to its number of occurrences.
+    void add_histogram(const std::string& key, const std::size_t* values,
+                       std::size_t n)
+    {
+        std::map<std::size_t, std::size_t> counts;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            counts[values[i]]++;
+        }
+        field(key);
+        record_ << '{';
+        for (auto it = counts.begin(); it != counts.end(); ++it)
+        {
+            record_ << (it == counts.begin() ? "" : ",") << '"' << it->first
+                    << "\":" << it->second;
+        }
+        record_ << '}';
+    }
+
+    //! Starts the timer of `phase`.
+    void start(const std::string& phase)
+    {
+        phase_ = phase;
+        begin_ = std::chrono::steady_clock::now();
+    }
+
+    //! Stops the timer started by start(), the times of the same phase are
+    //! summed within a record.
+    void stop()
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - begin_;
+        for (auto& t : times_)
+        {
+            if (t.first == phase_)
+            {
+                t.second += elapsed.count();
+                return;
+            }
+        }
+        times_.emplace_back(phase_, elapsed.count());
+    }
+
+    //! Writes the record as one line.
+    void end()
+    {
+        field("time");
+        record_ << '{';
+        for (std::size_t i = 0; i < times_.size(); i++)
+        {
+            record_ << (i == 0 ? "" : ",") << '"' << times_[i].first
+                    << "\":" << std::setprecision(6) << times_[i].second;
+        }
+        record_ << '}';
+        out_ << '{' << record_.str() << "}\n";
+        out_.flush();
+        record_.str("");
+        times_.clear();
+    }
+
+private:
+    void field(const std::string& key)
+    {
+        if (record_.tellp() > 0)
+        {
+            record_ << ',';
+        }
+        record_ << '"' << key << "\":";
+    }
+
+    std::string file_;
+    std::ofstream out_;
+    std::ostringstream record_;
+    std::size_t solve_ = 0;
+    std::size_t iteration_ = 0;
+    std::string phase_;
+    std::chrono::steady_clock::time_point begin_;
+    std::vector<std::pair<std::string, double>> times_;
+};
+
+} // namespace chase
+#endif
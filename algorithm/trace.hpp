@@ -0,0 +1,287 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#ifndef CHASE_ALGORITHM_TRACE_HPP
+#define CHASE_ALGORITHM_TRACE_HPP
+
+#ifndef NO_MPI
+#include <mpi.h>
+#endif
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace chase
+{
+//! Records a timeline of the kernels and collectives of ChASE in the Chrome
+//! trace-event format.
+/*! The tracer is a process-wide singleton, such that the collectives of
+    mpi_wrapper.hpp, which have no access to the configuration of the
+    solver, can record into it. It is disabled by default and enabled by
+    enable() or by setting the environment variable `CHASE_TRACE` to the
+    prefix of the output files. While it is disabled, a Scope costs a
+    single test.
+
+    Every Scope records one complete event (`"ph":"X"`) with its begin
+    time and duration in microseconds, the methods of
+    PerformanceDecoratorChase are recorded in the category `chase` and the
+    collectives in the category `mpi`, with the size of their buffer. The
+    collectives of the NCCL backend are asynchronous, their events only
+    cover the enqueueing of the operation. The events are kept in memory
+    until write() or clear(). write() is collective over a communicator and
+    writes
+    - `<prefix>.<rank>.json`, the events of each rank on its local clock,
+    - `<prefix>.json` on rank 0, the events of all the ranks with one
+    process per rank, shifted to the clock of rank 0.
+
+    The offset between the clock of a rank and the one of rank 0 is
+    estimated from the ping-pong of smallest round-trip time, it is
+    accurate up to half of that round-trip time. The files can be opened in
+    `chrome://tracing` or https://ui.perfetto.dev. The tracer is not thread
+    safe, the events must be recorded by the thread calling ChASE.
+ */
+class ChaseTracer
+{
+public:
+    //! Returns the tracer of the process.
+    static ChaseTracer& get()
+    {
+        static ChaseTracer tracer;
+        return tracer;
+    }
+
+    //! Records a complete event from its construction to its destruction.
+    class Scope
+    {
+    public:
+        //! `name` and `cat` must outlive the tracer, e.g. string literals.
+        //! A non-zero `bytes` is written as an argument of the event.
+        Scope(const char* name, const char* cat, std::size_t bytes = 0)
+            : name_(name), cat_(cat), bytes_(bytes),
+              begin_(ChaseTracer::get().enabled() ? ChaseTracer::now() : -1)
+        {
+        }
+
+        ~Scope()
+        {
+            if (begin_ >= 0)
+            {
+                ChaseTracer::get().record(name_, cat_, begin_,
+                                          ChaseTracer::now(), bytes_);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name_;
+        const char* cat_;
+        std::size_t bytes_;
+        double begin_;
+    };
+
+    //! Enables the recording, the files are written with `prefix`.
+    void enable(const std::string& prefix)
+    {
+        prefix_ = prefix;
+        enabled_ = true;
+    }
+
+    //! Disables the recording, the recorded events are kept.
+    void disable() { enabled_ = false; }
+
+    bool enabled() const { return enabled_; }
+
+    const std::string& prefix() const { return prefix_; }
+
+    //! Discards the recorded events.
+    void clear() { events_.clear(); }
+
+    //! Microseconds on the local steady clock.
+    static double now()
+    {
+        return std::chrono::duration<double, std::micro>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    //! Records an event from `begin` to `end`, as returned by now().
+    void record(const char* name, const char* cat, double begin, double end,
+                std::size_t bytes = 0)
+    {
+        events_.push_back({name, cat, begin, end - begin, bytes});
+    }
+
+#ifdef NO_MPI
+    //! Writes `<prefix>.0.json`, does nothing if the tracer is disabled.
+    void write()
+    {
+        if (!enabled_)
+        {
+            return;
+        }
+        std::ofstream out(prefix_ + ".0.json");
+        out << "{\"traceEvents\":[" << events(0, 0) << "]}\n";
+    }
+#else
+    //! Writes the file of every rank of `comm` and the merged file on its
+    //! rank 0. It is collective over `comm` and does nothing if the tracer
+    //! is disabled, which must be the case on all the ranks or on none.
+    void write(MPI_Comm comm)
+    {
+        if (!enabled_)
+        {
+            return;
+        }
+        MPI_Comm c;
+        MPI_Comm_dup(comm, &c);
+        int rank, size;
+        MPI_Comm_rank(c, &rank);
+        MPI_Comm_size(c, &size);
+
+        {
+            std::ofstream out(prefix_ + "." + std::to_string(rank) + ".json");
+            out << "{\"traceEvents\":[" << events(rank, 0) << "]}\n";
+        }
+
+        std::string local = events(rank, offset(c));
+        int len = static_cast<int>(local.size());
+        std::vector<int> lens(size), displs(size, 0);
+        MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, c);
+        for (int r = 1; r < size; r++)
+        {
+            displs[r] = displs[r - 1] + lens[r - 1];
+        }
+        std::string all(rank == 0 ? displs[size - 1] + lens[size - 1] : 0,
+                        ' ');
+        MPI_Gatherv(local.data(), len, MPI_CHAR, &all[0], lens.data(),
+                    displs.data(), MPI_CHAR, 0, c);
+
+        if (rank == 0)
+        {
+            std::ofstream out(prefix_ + ".json");
+            out << "{\"traceEvents\":[";
+            bool first = true;
+            for (int r = 0; r < size; r++)
+            {
+                if (lens[r] > 0)
+                {
+                    out << (first ? "" : ",\n")
+                        << all.substr(displs[r], lens[r]);
+                    first = false;
+                }
+            }
+            out << "]}\n";
+        }
+        MPI_Comm_free(&c);
+    }
+#endif
+
+private:
+    struct Event
+    {
+        const char* name;
+        const char* cat;
+        double ts;
+        double dur;
+        std::size_t bytes;
+    };
+
+    ChaseTracer()
+    {
+        if (const char* prefix = std::getenv("CHASE_TRACE"))
+        {
+            if (*prefix != '\0')
+            {
+                enable(prefix);
+            }
+        }
+    }
+
+#ifndef NO_MPI
+    //! Offset of the clock of this rank to the one of rank 0 of `comm`.
+    static double offset(MPI_Comm comm)
+    {
+        const int rounds = 8;
+        int rank, size;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        double off = 0;
+        if (rank == 0)
+        {
+            for (int r = 1; r < size; r++)
+            {
+                double best = std::numeric_limits<double>::max();
+                double off_r = 0;
+                for (int k = 0; k < rounds; k++)
+                {
+                    double t0 = now(), tr;
+                    MPI_Send(&t0, 1, MPI_DOUBLE, r, 0, comm);
+                    MPI_Recv(&tr, 1, MPI_DOUBLE, r, 0, comm,
+                             MPI_STATUS_IGNORE);
+                    double t1 = now();
+                    if (t1 - t0 < best)
+                    {
+                        best = t1 - t0;
+                        off_r = tr - (t0 + t1) / 2;
+                    }
+                }
+                MPI_Send(&off_r, 1, MPI_DOUBLE, r, 1, comm);
+            }
+        }
+        else
+        {
+            for (int k = 0; k < rounds; k++)
+            {
+                double t;
+                MPI_Recv(&t, 1, MPI_DOUBLE, 0, 0, comm, MPI_STATUS_IGNORE);
+                t = now();
+                MPI_Send(&t, 1, MPI_DOUBLE, 0, 0, comm);
+            }
+            MPI_Recv(&off, 1, MPI_DOUBLE, 0, 1, comm, MPI_STATUS_IGNORE);
+        }
+        return off;
+    }
+#endif
+
+    //! The events as comma-separated JSON objects of process `pid`, shifted
+    //! by `-offset`.
+    std::string events(int pid, double offset) const
+    {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3);
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+           << ",\"args\":{\"name\":\"rank " << pid << "\"}}";
+        for (auto& e : events_)
+        {
+            os << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << e.cat
+               << "\",\"ph\":\"X\",\"pid\":" << pid
+               << ",\"tid\":0,\"ts\":" << e.ts - offset
+               << ",\"dur\":" << e.dur;
+            if (e.bytes > 0)
+            {
+                os << ",\"args\":{\"bytes\":" << e.bytes << '}';
+            }
+            os << '}';
+        }
+        return os.str();
+    }
+
+    bool enabled_ = false;
+    std::string prefix_;
+    std::vector<Event> events_;
+};
+
+} // namespace chase
+#endif
@@ -33,6 +33,23 @@ struct Base_Class<std::complex<Q>>
 
 template <typename Q>
 using Base = typename Base_Class<Q>::type;
+
+// Single< std::complex< Base<T> > > -> std::complex<float>
+// Single<               Base<T>   > -> float
+template <class Q>
+struct Single_Class
+{
+    typedef float type;
+};
+
+template <class Q>
+struct Single_Class<std::complex<Q>>
+{
+    typedef std::complex<float> type;
+};
+
+template <typename Q>
+using Single = typename Single_Class<Q>::type;
 } // namespace chase
 
 bool isPathExist(const std::string& s)
@@ -0,0 +1,107 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+#ifndef CHASE_ALGORITHM_WORKSPACE_HPP
+#define CHASE_ALGORITHM_WORKSPACE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace chase
+{
+
+//! The temporaries of a solver which are held by a Workspace. Two buffers
+//! which are alive at the same time must use different slots.
+enum class WorkspaceSlot : std::size_t
+{
+    Tau,           //!< Householder scalars of the QR factorization
+    Block,         //!< a `(nev+nex) * (nev+nex)` matrix, e.g. in RR()
+    Column,        //!< a single vector, e.g. in Swap()/Permute()
+    Redundant,     //!< the redundantly gathered vectors of size `N*(nev+nex)`
+    Singular,      //!< singular values in estimated_cond_evaluator()
+    Norms,         //!< sorted norms in estimated_cond_evaluator()
+    LanczosTheta,  //!< Ritz values of the Lanczos procedures
+    LanczosTau,    //!< first entries of the Ritz vectors of the procedures
+    LanczosRitzV,  //!< Ritz vectors of the last Lanczos procedure
+    LanczosRitzVc, //!< the same Ritz vectors converted to the scalar type
+    LanczosSorted, //!< the sorted Ritz values of all the procedures
+    LanczosV0,     //!< Lanczos vectors of step `k-1`
+    LanczosV1,     //!< Lanczos vectors of step `k`
+    LanczosV2,     //!< Lanczos vectors of step `k+1`
+    LanczosW,      //!< Lanczos vectors in the layout of `B`
+    TsqrLocal,     //!< the local Householder factor of a TSQR
+    TsqrTree,      //!< the factors of the reduction tree of a TSQR
+    TsqrStack,     //!< the stacked `R` factors and messages of a TSQR
+    Packed,        //!< a packed triangle of a Hermitian matrix
+    Count
+};
+
+//! @brief A pool of reusable CPU buffers for the temporaries of a solver.
+/*!
+  Each buffer is identified by a WorkspaceSlot, and it only grows: requesting
+  a slot with a size which is not larger than any previous request returns
+  the same memory. After the first iteration, a sequence of solves thus runs
+  without any heap traffic for these temporaries, and no memory is leaked.
+  The content of a buffer is unspecified on return.
+*/
+class Workspace
+{
+public:
+    //! Returns a buffer of at least `count` elements of type `U` for `slot`.
+    template <typename U>
+    U* get(WorkspaceSlot slot, std::size_t count)
+    {
+        auto& buf = slots_[static_cast<std::size_t>(slot)];
+        std::size_t words =
+            (count * sizeof(U) + sizeof(std::max_align_t) - 1) /
+            sizeof(std::max_align_t);
+        if (buf.size() < words)
+        {
+            buf.resize(words);
+        }
+        return reinterpret_cast<U*>(buf.data());
+    }
+
+    //! The same as get(), with the first `count` elements set to zero.
+    template <typename U>
+    U* zeros(WorkspaceSlot slot, std::size_t count)
+    {
+        U* ptr = get<U>(slot, count);
+        std::fill_n(ptr, count, U(0));
+        return ptr;
+    }
+
+    //! Grows `slot` to hold at least `count` elements of type `U` ahead of
+    //! its first use.
+    template <typename U>
+    void reserve(WorkspaceSlot slot, std::size_t count)
+    {
+        get<U>(slot, count);
+    }
+
+    //! Returns the number of bytes held by all the slots.
+    std::size_t bytes() const
+    {
+        std::size_t n = 0;
+        for (auto& buf : slots_)
+        {
+            n += buf.size() * sizeof(std::max_align_t);
+        }
+        return n;
+    }
+
+private:
+    std::array<std::vector<std::max_align_t>,
+               static_cast<std::size_t>(WorkspaceSlot::Count)>
+        slots_;
+};
+
+} // namespace chase
+
+#endif
@@ -18,6 +18,10 @@
 #include "ChASE-MPI/chase_mpi.hpp"
 #include "algorithm/performance.hpp"
 
+#ifdef USE_MPI
+#include "ChASE-MPI/chase_mpi_autotune.hpp"
+#endif
+
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq.hpp"
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq_inplace.hpp"
 
@@ -90,6 +94,8 @@ struct ChASE_DriverProblemConfig
     std::size_t lanczosIter;
     std::size_t numLanczos;
 
+    bool autotune; // choose the grid with ChaseMpiAutotuner
+
 #ifdef USE_BLOCK_CYCLIC
     std::size_t mbsize;
     std::size_t nbsize;
@@ -170,21 +176,44 @@ int do_chase(ChASE_DriverProblemConfig& conf)
 #ifdef USE_MPI
 #if defined(DRIVER_BUILD_MGPU)
     typedef ChaseMpi<ChaseMpiDLAMultiGPU, T> CHASE;
+    typedef ChaseMpiAutotuner<ChaseMpiDLAMultiGPU, T> TUNER;
 #else
     typedef ChaseMpi<ChaseMpiDLABlaslapack, T> CHASE;
+    typedef ChaseMpiAutotuner<ChaseMpiDLABlaslapack, T> TUNER;
 #endif // CUDA or not
 #else
     typedef ChaseMpi<ChaseMpiDLABlaslapackSeq, T> CHASE;
 #endif // seq ChASE
 
 #ifdef USE_MPI
+    ChaseMpiProperties<T>* props;
+    if (conf.autotune)
+    {
+        TUNER tuner(N, nev, nex, MPI_COMM_WORLD);
+        tuner.set_deg(deg);
+#ifdef USE_BLOCK_CYCLIC
+        // the matrix is read in the Block-Cyclic distribution
+        tuner.set_block_block(false);
+        tuner.set_block_sizes({std::max<std::size_t>(1, mbsize / 2), mbsize,
+                               2 * mbsize});
+#endif
+        ChaseMpiGrid grid = tuner.tune();
+        tuner.print();
+        if (rank == 0)
+            std::cout << "autotuned grid: " << grid.dim0 << "x" << grid.dim1
+                      << ", block size " << grid.mb << "\n";
+        props = tuner.create(grid);
+    }
+    else
+    {
 #ifdef USE_BLOCK_CYCLIC
-    auto props = new ChaseMpiProperties<T>(
-        N, mbsize, nbsize, nev, nex, dim0, dim1,
-        const_cast<char*>(major.c_str()), irsrc, icsrc, MPI_COMM_WORLD);
+        props = new ChaseMpiProperties<T>(
+            N, mbsize, nbsize, nev, nex, dim0, dim1,
+            const_cast<char*>(major.c_str()), irsrc, icsrc, MPI_COMM_WORLD);
 #else
-    auto props = new ChaseMpiProperties<T>(N, nev, nex, MPI_COMM_WORLD);
+        props = new ChaseMpiProperties<T>(N, nev, nex, MPI_COMM_WORLD);
 #endif
+    }
 #endif
 
 #ifdef USE_MPI
@@ -319,94 +348,94 @@ int do_chase(ChASE_DriverProblemConfig& conf)
         nvtxRangePushA("MatrixIO");
 #endif
 
-        if (rank == 0)
-            std::cout << "start reading matrix\n";
+#ifdef USE_MPI
+        if (isMatGen)
+        {
+            if (rank == 0)
+                std::cout << "generating matrix in place\n";
 
-        std::ostringstream problem(std::ostringstream::ate);
-        if (sequence)
+            // eigenvalues evenly spread over [dmax * epsilon, dmax), rotated
+            // by two random Householder reflectors
+            Base<T> epsilon = 1e-4;
+            std::vector<Base<T>> eigenv(N);
+            for (std::size_t i = 0; i < N; i++)
+            {
+                eigenv[i] = dmax * (epsilon + (Base<T>)i * (1.0 - epsilon) /
+                                                  (Base<T>)N);
+            }
+            props->generateHamiltonianSpectrum(eigenv.data(), H);
+        }
+        else
+#endif
         {
-            if (legacy)
+            if (rank == 0)
+                std::cout << "start reading matrix\n";
+
+            std::ostringstream problem(std::ostringstream::ate);
+            if (sequence)
             {
-                problem << path_in << "gmat  1 " << std::setw(2) << i << ".bin";
+                if (legacy)
+                {
+                    problem << path_in << "gmat  1 " << std::setw(2) << i
+                            << ".bin";
+                }
+                else
+                {
+                    problem << path_in << "mat_" << spin << "_"
+                            << std::setfill('0') << std::setw(2) << kpoint
+                            << "_" << std::setfill('0') << std::setw(2) << i
+                            << ".bin";
+                }
             }
             else
             {
-                problem << path_in << "mat_" << spin << "_" << std::setfill('0')
-                        << std::setw(2) << kpoint << "_" << std::setfill('0')
-                        << std::setw(2) << i << ".bin";
+                problem << path_in;
             }
-        }
-        else
-        {
-            problem << path_in;
-        }
 
-        if (rank == 0)
-            std::cout << "Reading matrix: " << problem.str() << std::endl;
+            if (rank == 0)
+                std::cout << "Reading matrix: " << problem.str()
+                          << std::endl;
 
-        std::size_t file_size = GetFileSize(problem.str());
+            std::size_t file_size = GetFileSize(problem.str());
 
-        // check the input file size
-        try
-        {
-            if (N * N * sizeof(T) != file_size)
+            // check the input file size
+            try
             {
-                throw std::logic_error(
-                    std::string("The given file : ") + problem.str() +
-                    std::string(" of size ") + std::to_string(file_size) +
-                    std::string(" doesn't equals to the required size of "
-                                "matrix of size ") +
-                    std::to_string(N * N * sizeof(T)));
+                if (N * N * sizeof(T) != file_size)
+                {
+                    throw std::logic_error(
+                        std::string("The given file : ") + problem.str() +
+                        std::string(" of size ") + std::to_string(file_size) +
+                        std::string(" doesn't equals to the required size of "
+                                    "matrix of size ") +
+                        std::to_string(N * N * sizeof(T)));
+                }
+            }
+            catch (std::exception& e)
+            {
+                std::cerr << "Caught " << typeid(e).name() << " : " << e.what()
+                          << std::endl;
+                return 1;
             }
-        }
-        catch (std::exception& e)
-        {
-            std::cerr << "Caught " << typeid(e).name() << " : " << e.what()
-                      << std::endl;
-            return 1;
-        }
 
 #ifdef USE_MPI
 #ifdef USE_BLOCK_CYCLIC
-        props->readHamiltonianBlockCyclicDist(problem.str(), H);
+            props->readHamiltonianBlockCyclicDist(problem.str(), H);
 #else
-        if (isMatGen)
-        {
-            Base<T> epsilon = 1e-4;
-            Base<T>* eigenv = new Base<T>[N];
-            for (std::size_t i = 0; i < ylen; i++)
-            {
-                for (std::size_t j = 0; j < xlen; j++)
-                {
-                    if (xoff + j == (i + yoff))
-                    {
-                        H[i * xlen + j] =
-                            dmax * (epsilon + (Base<T>)(xoff + j) *
-                                                  (1.0 - epsilon) / (Base<T>)N);
-                    }
-                    else
-                    {
-                        H[i * xlen + j] = T(0.0);
-                    }
-                }
-            }
-        }
-        else
-        {
             props->readHamiltonianBlockDist(problem.str(), H);
-        }
 #endif
 #else
-        std::ifstream input(problem.str().c_str(), std::ios::binary);
-        if (input.is_open())
-        {
-            input.read((char*)H, sizeof(T) * N * N);
-        }
-        else
-        {
-            throw std::string("error reading file: ") + problem.str();
-        }
+            std::ifstream input(problem.str().c_str(), std::ios::binary);
+            if (input.is_open())
+            {
+                input.read((char*)H, sizeof(T) * N * N);
+            }
+            else
+            {
+                throw std::string("error reading file: ") + problem.str();
+            }
 #endif
+        }
 
 #ifdef USE_MPI
         MPI_Barrier(MPI_COMM_WORLD);
@@ -458,8 +487,16 @@ int do_chase(ChASE_DriverProblemConfig& conf)
             std::cout << "\n\n\n";
 #endif
         }
+#ifdef USE_MPI
+        performanceDecorator.GetPerfData().print_summary(MPI_COMM_WORLD);
+#endif
     }
 
+#ifdef USE_MPI
+    // written only if CHASE_TRACE is set
+    ChaseTracer::get().write(MPI_COMM_WORLD);
+#endif
+
 #ifdef HAS_UM
     /*Free the memory of the matrix*/
     cudaFree(V);
@@ -534,6 +571,12 @@ int main(int argc, char* argv[])
                                  "Sets the number of stochastic vectors used "
                                  "for the spectral estimates in Lanczos",
                                  4, &conf.numLanczos);
+#ifdef USE_MPI
+    desc.add<Value<bool>>("", "autotune",
+                          "Choose the MPI proc grid and the block size from "
+                          "timings of the main kernels",
+                          false, &conf.autotune);
+#endif
     auto isMatGen_options = desc.add<Value<bool>>(
         "", "isMatGen", "generating a matrix in place", false, &conf.isMatGen);
     desc.add<Value<double>>("", "dmax", "Tolerance for Eigenpair convergence",
@@ -647,11 +690,6 @@ int main(int argc, char* argv[])
         return -1;
     }
 
-    if (conf.isMatGen)
-    {
-        conf.iscomplex = false;
-    }
-
     if (conf.isdouble)
     {
         if (conf.iscomplex)
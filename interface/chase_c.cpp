@@ -11,6 +11,7 @@
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq.hpp"
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq_inplace.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_matrixfree_seq.hpp"
 #include "algorithm/performance.hpp"
 #include <algorithm>
 #include <chrono>
@@ -47,6 +48,10 @@ public:
     template <typename T>
     static void Initialize(int N, int nev, int nex, T* H, int ldh, T* V, Base<T>* ritzv);
 
+    template <typename T>
+    static void Initialize(int N, int nev, int nex, MatrixFreeApply<T> op, T* V,
+                           Base<T>* ritzv);
+
     template <typename T>
     static void Finalize();
 
@@ -94,6 +99,46 @@ void ChASE_SEQ::Initialize(int N, int nev, int nex, std::complex<float>* H, int
         new ChaseMpi<dlaSeq, std::complex<float>>(N, nev, nex, H, ldh, V, ritzv);
 }
 
+template <>
+void ChASE_SEQ::Initialize(int N, int nev, int nex, MatrixFreeApply<double> op,
+                           double* V, double* ritzv)
+{
+    dchaseSeq = new ChaseMpi<dlaSeq, double>(
+        N, nev, nex,
+        new ChaseMpiDLAMatrixFreeSeq<double>(op, V, ritzv, N, nev, nex));
+}
+
+template <>
+void ChASE_SEQ::Initialize(int N, int nev, int nex, MatrixFreeApply<float> op,
+                           float* V, float* ritzv)
+{
+    schaseSeq = new ChaseMpi<dlaSeq, float>(
+        N, nev, nex,
+        new ChaseMpiDLAMatrixFreeSeq<float>(op, V, ritzv, N, nev, nex));
+}
+
+template <>
+void ChASE_SEQ::Initialize(int N, int nev, int nex,
+                           MatrixFreeApply<std::complex<double>> op,
+                           std::complex<double>* V, double* ritzv)
+{
+    zchaseSeq = new ChaseMpi<dlaSeq, std::complex<double>>(
+        N, nev, nex,
+        new ChaseMpiDLAMatrixFreeSeq<std::complex<double>>(op, V, ritzv, N, nev,
+                                                           nex));
+}
+
+template <>
+void ChASE_SEQ::Initialize(int N, int nev, int nex,
+                           MatrixFreeApply<std::complex<float>> op,
+                           std::complex<float>* V, float* ritzv)
+{
+    cchaseSeq = new ChaseMpi<dlaSeq, std::complex<float>>(
+        N, nev, nex,
+        new ChaseMpiDLAMatrixFreeSeq<std::complex<float>>(op, V, ritzv, N, nev,
+                                                          nex));
+}
+
 template <>
 void ChASE_SEQ::Finalize<double>()
 {
@@ -149,6 +194,33 @@ int ChASE_SEQ_Init(int N, int nev, int nex, T* H, int ldh, T* V, Base<T>* ritzv)
     return 1;
 }
 
+//! Wraps a Fortran-compatible apply function, which takes all its arguments
+//! by reference, into a MatrixFreeApply.
+template <typename T, typename CT>
+MatrixFreeApply<T> ChASE_SEQ_Wrap(void (*apply)(int*, CT*, Base<T>*, CT*, int*,
+                                                CT*, CT*, int*))
+{
+    return [apply](std::size_t block, T alpha, Base<T> c, T* X,
+                   std::size_t ldx, T beta, T* Y, std::size_t ldy) {
+        int b = block;
+        int ldx_ = ldx;
+        int ldy_ = ldy;
+        apply(&b, reinterpret_cast<CT*>(&alpha), &c, reinterpret_cast<CT*>(X),
+              &ldx_, reinterpret_cast<CT*>(&beta), reinterpret_cast<CT*>(Y),
+              &ldy_);
+    };
+}
+
+template <typename T, typename CT>
+int ChASE_SEQ_Init(int N, int nev, int nex,
+                   void (*apply)(int*, CT*, Base<T>*, CT*, int*, CT*, CT*, int*),
+                   T* V, Base<T>* ritzv)
+{
+    ChASE_SEQ::Initialize<T>(N, nev, nex, ChASE_SEQ_Wrap<T, CT>(apply), V,
+                             ritzv);
+    return 1;
+}
+
 template <typename T>
 int ChASE_SEQ_Finalize()
 {
@@ -584,6 +656,67 @@ extern "C"
             *N, *nev, *nex, reinterpret_cast<std::complex<double>*>(H), *ldh,
             reinterpret_cast<std::complex<double>*>(V), ritzv);
     }
+    //! Initialization of shared-memory ChASE with real scalar in double
+    //! precison, without an explicitly stored matrix. The matrix is only
+    //! accessed through `apply`, which computes
+    //! `y = alpha * (h - c * I) * x + beta * y` on a block of vectors. The
+    //! solver is then used through dchase_() and dchase_finalize_().
+    //!
+    //! @param[in] n global matrix size of the matrix to be diagonalized
+    //! @param[in] nev number of desired eigenpairs
+    //! @param[in] nex extra searching space size
+    //! @param[in] apply a function `apply(block, alpha, c, x, ldx, beta, y,
+    //! ldy)`, with all arguments passed by reference, in which `x` and `y`
+    //! are `(n x block)` matrices with leading dimensions `ldx` and `ldy`
+    //! @param[in,out] v `(nx(nev+nex))` matrix, input is the initial guess
+    //! eigenvectors, and for output, the first `nev` columns are overwritten by
+    //! the desired eigenvectors
+    //! @param[in,out] ritzv an array of size `nev` which contains the desired
+    //! eigenvalues
+    //! @param[in,out] init a flag to indicate if ChASE has been initialized
+    void dchase_init_matrixfree_(int* N, int* nev, int* nex,
+                                 void (*apply)(int*, double*, double*, double*,
+                                               int*, double*, double*, int*),
+                                 double* V, double* ritzv, int* init)
+    {
+        *init = ChASE_SEQ_Init<double, double>(*N, *nev, *nex, apply, V, ritzv);
+    }
+    //! Initialization of shared-memory ChASE with real scalar in single
+    //! precison, without an explicitly stored matrix. See
+    //! dchase_init_matrixfree_() for the arguments.
+    void schase_init_matrixfree_(int* N, int* nev, int* nex,
+                                 void (*apply)(int*, float*, float*, float*,
+                                               int*, float*, float*, int*),
+                                 float* V, float* ritzv, int* init)
+    {
+        *init = ChASE_SEQ_Init<float, float>(*N, *nev, *nex, apply, V, ritzv);
+    }
+    //! Initialization of shared-memory ChASE with complex scalar in single
+    //! precison, without an explicitly stored matrix. See
+    //! dchase_init_matrixfree_() for the arguments, `c` is real.
+    void cchase_init_matrixfree_(
+        int* N, int* nev, int* nex,
+        void (*apply)(int*, float _Complex*, float*, float _Complex*, int*,
+                      float _Complex*, float _Complex*, int*),
+        float _Complex* V, float* ritzv, int* init)
+    {
+        *init = ChASE_SEQ_Init<std::complex<float>, float _Complex>(
+            *N, *nev, *nex, apply, reinterpret_cast<std::complex<float>*>(V),
+            ritzv);
+    }
+    //! Initialization of shared-memory ChASE with complex scalar in double
+    //! precison, without an explicitly stored matrix. See
+    //! dchase_init_matrixfree_() for the arguments, `c` is real.
+    void zchase_init_matrixfree_(
+        int* N, int* nev, int* nex,
+        void (*apply)(int*, double _Complex*, double*, double _Complex*, int*,
+                      double _Complex*, double _Complex*, int*),
+        double _Complex* V, double* ritzv, int* init)
+    {
+        *init = ChASE_SEQ_Init<std::complex<double>, double _Complex>(
+            *N, *nev, *nex, apply, reinterpret_cast<std::complex<double>*>(V),
+            ritzv);
+    }
     //! Finalize shared-memory ChASE with real scalar in double precison.
     //!
     //! @param[in,out] flag A flag to indicate if ChASE has been cleared up
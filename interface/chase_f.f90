@@ -223,6 +223,94 @@ MODULE chase_diag
         END SUBROUTINE zchase    
     END INTERFACE
 
+    INTERFACE
+        SUBROUTINE dchase_init_matrixfree(n, nev, nex, apply, v, ritzv, init) bind( c, name = 'dchase_init_matrixfree_' )
+      !> Initialization of shared-memory ChASE with real scalar in double precison, without an explicitly stored matrix.
+      !> The matrix is only accessed through `apply`, the solver is then used through dchase and dchase_finalize.
+      !>    
+      !>
+      !> @param[in] n global matrix size of the matrix to be diagonalized  
+      !> @param[in] nev number of desired eigenpairs
+      !> @param[in] nex extra searching space size      
+      !> @param[in] apply `c_funloc` of a `bind(c)` subroutine `apply(block, alpha, c, x, ldx, beta, y, ldy)` computing `y = alpha * (h - c * I) * x + beta * y` on `(nxblock)` matrices, `c` being real
+      !> @param[in,out] v `(nx(nev+nex))` matrix, input is the initial guess eigenvectors, and for output, the first `nev` columns are overwritten by the desired eigenvectors
+      !> @param[in,out] ritzv an array of size `nev` which contains the desired eigenvalues
+      !> @param[in,out] init a flag to indicate if ChASE has been initialized
+            USE, INTRINSIC :: iso_c_binding
+            INTEGER(c_int)      :: n, nev, nex, init
+            TYPE(c_funptr), VALUE :: apply
+            REAL(c_double)      :: v(n, *)
+            REAL(c_double)      :: ritzv(*)
+
+        END SUBROUTINE dchase_init_matrixfree
+    END INTERFACE
+
+    INTERFACE
+        SUBROUTINE schase_init_matrixfree(n, nev, nex, apply, v, ritzv, init) bind( c, name = 'schase_init_matrixfree_' )
+      !> Initialization of shared-memory ChASE with real scalar in single precison, without an explicitly stored matrix.
+      !> The matrix is only accessed through `apply`, the solver is then used through schase and schase_finalize.
+      !>    
+      !>
+      !> @param[in] n global matrix size of the matrix to be diagonalized  
+      !> @param[in] nev number of desired eigenpairs
+      !> @param[in] nex extra searching space size      
+      !> @param[in] apply `c_funloc` of a `bind(c)` subroutine `apply(block, alpha, c, x, ldx, beta, y, ldy)` computing `y = alpha * (h - c * I) * x + beta * y` on `(nxblock)` matrices, `c` being real
+      !> @param[in,out] v `(nx(nev+nex))` matrix, input is the initial guess eigenvectors, and for output, the first `nev` columns are overwritten by the desired eigenvectors
+      !> @param[in,out] ritzv an array of size `nev` which contains the desired eigenvalues
+      !> @param[in,out] init a flag to indicate if ChASE has been initialized
+            USE, INTRINSIC :: iso_c_binding
+            INTEGER(c_int)      :: n, nev, nex, init
+            TYPE(c_funptr), VALUE :: apply
+            REAL(c_float)      :: v(n, *)
+            REAL(c_float)      :: ritzv(*)
+
+        END SUBROUTINE schase_init_matrixfree
+    END INTERFACE
+
+    INTERFACE
+        SUBROUTINE cchase_init_matrixfree(n, nev, nex, apply, v, ritzv, init) bind( c, name = 'cchase_init_matrixfree_' )
+      !> Initialization of shared-memory ChASE with complex scalar in single precison, without an explicitly stored matrix.
+      !> The matrix is only accessed through `apply`, the solver is then used through cchase and cchase_finalize.
+      !>    
+      !>
+      !> @param[in] n global matrix size of the matrix to be diagonalized  
+      !> @param[in] nev number of desired eigenpairs
+      !> @param[in] nex extra searching space size      
+      !> @param[in] apply `c_funloc` of a `bind(c)` subroutine `apply(block, alpha, c, x, ldx, beta, y, ldy)` computing `y = alpha * (h - c * I) * x + beta * y` on `(nxblock)` matrices, `c` being real
+      !> @param[in,out] v `(nx(nev+nex))` matrix, input is the initial guess eigenvectors, and for output, the first `nev` columns are overwritten by the desired eigenvectors
+      !> @param[in,out] ritzv an array of size `nev` which contains the desired eigenvalues
+      !> @param[in,out] init a flag to indicate if ChASE has been initialized
+            USE, INTRINSIC :: iso_c_binding
+            INTEGER(c_int)      :: n, nev, nex, init
+            TYPE(c_funptr), VALUE :: apply
+            COMPLEX(c_float_complex)      :: v(n, *)
+            REAL(c_float)      :: ritzv(*)
+
+        END SUBROUTINE cchase_init_matrixfree
+    END INTERFACE
+
+    INTERFACE
+        SUBROUTINE zchase_init_matrixfree(n, nev, nex, apply, v, ritzv, init) bind( c, name = 'zchase_init_matrixfree_' )
+      !> Initialization of shared-memory ChASE with complex scalar in double precison, without an explicitly stored matrix.
+      !> The matrix is only accessed through `apply`, the solver is then used through zchase and zchase_finalize.
+      !>    
+      !>
+      !> @param[in] n global matrix size of the matrix to be diagonalized  
+      !> @param[in] nev number of desired eigenpairs
+      !> @param[in] nex extra searching space size      
+      !> @param[in] apply `c_funloc` of a `bind(c)` subroutine `apply(block, alpha, c, x, ldx, beta, y, ldy)` computing `y = alpha * (h - c * I) * x + beta * y` on `(nxblock)` matrices, `c` being real
+      !> @param[in,out] v `(nx(nev+nex))` matrix, input is the initial guess eigenvectors, and for output, the first `nev` columns are overwritten by the desired eigenvectors
+      !> @param[in,out] ritzv an array of size `nev` which contains the desired eigenvalues
+      !> @param[in,out] init a flag to indicate if ChASE has been initialized
+            USE, INTRINSIC :: iso_c_binding
+            INTEGER(c_int)      :: n, nev, nex, init
+            TYPE(c_funptr), VALUE :: apply
+            COMPLEX(c_double_complex)      :: v(n, *)
+            REAL(c_double)      :: ritzv(*)
+
+        END SUBROUTINE zchase_init_matrixfree
+    END INTERFACE
+
 
     INTERFACE   
         SUBROUTINE pdchase_init(nn, nev, nex, m, n, h, ldh, v, ritzv, dim0, dim1, grid_major, fcomm, init) &
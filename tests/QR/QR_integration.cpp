@@ -35,8 +35,12 @@ public:
     MOCK_METHOD(void, initVecs, (), (override));
     MOCK_METHOD(void, initRndVecs, (), (override));
     MOCK_METHOD(void, apply, (T, T, std::size_t, std::size_t, std::size_t), (override));
+    MOCK_METHOD(void, applyChunk, (T, T, std::size_t, std::size_t, std::size_t, bool), (override));
+    MOCK_METHOD(bool, enterSinglePrecision, (std::size_t), (override));
+    MOCK_METHOD(void, leaveSinglePrecision, (std::size_t), (override));
     MOCK_METHOD(void, asynCxHGatherC, (std::size_t, std::size_t, bool), (override));
     MOCK_METHOD(void, Swap, (std::size_t, std::size_t), (override));
+    MOCK_METHOD(void, Permute, (const std::vector<std::size_t>&), (override));
     MOCK_METHOD(void, applyVec, (T*, T*, std::size_t), (override));
     MOCK_METHOD(int, get_nprocs, (), (const, override));
     MOCK_METHOD(chase::Base<T>*, get_Resids, (), (override));
@@ -55,7 +59,9 @@ public:
     MOCK_METHOD(void, trsm, (char, char, char, char, std::size_t, std::size_t, T*, T*, std::size_t, T*, std::size_t, bool), (override));
     MOCK_METHOD(void, heevd, (int, char, char, std::size_t, T*, std::size_t, chase::Base<T>*), (override));
     MOCK_METHOD(void, Resd, (chase::Base<T>*, chase::Base<T>*, std::size_t, std::size_t), (override));
+    MOCK_METHOD(void, RRResd, (std::size_t, std::size_t, chase::Base<T>*, chase::Base<T>*), (override));
     MOCK_METHOD(void, hhQR, (std::size_t), (override));
+    MOCK_METHOD(void, tsQR, (std::size_t), (override));
     MOCK_METHOD(int, cholQR1, (std::size_t), (override));
     MOCK_METHOD(int, cholQR2, (std::size_t), (override));
     MOCK_METHOD(int, shiftedcholQR2, (std::size_t), (override));
@@ -2,6 +2,7 @@
 
 //typedef ::testing::Types<float, double, std::complex<float>, std::complex<double>> MyTypes;
 TYPED_TEST_SUITE(QRfixture, MyTypes);
+TYPED_TEST_SUITE(QRfixtureTallSkinny, MyTypes);
 
 TYPED_TEST(QRfixture, NumberOfProcs)
 {
@@ -79,6 +80,66 @@ TYPED_TEST(QRfixture, cholQR2IllCond)
     EXPECT_LE(info, this->nev + this->nex);
 }
 
+TYPED_TEST(QRfixture, cholQR1Locked)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+    std::size_t locked = 20;
+    T2* C = this->Matrices->C().host();
+
+    // orthonormal locked columns, well conditioned active columns
+    read_vectors(C, GetFileName<T2>() + "cond_10.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    this->Matrices->C().syncFromPtr();
+    ASSERT_EQ(this->DLA->cholQR2(0), 0);
+    this->Matrices->C().sync2Ptr();
+    std::vector<T2> V(C, C + this->m * nevex);
+    read_vectors(V.data(), GetFileName<T2>() + "cond_10.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::copy(V.begin() + this->m * locked, V.end(), C + this->m * locked);
+    std::vector<T2> A(C, C + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    int info = this->DLA->cholQR1(locked);
+    ASSERT_EQ(info, 0);
+    this->Matrices->C().sync2Ptr();
+
+    // the active columns are orthonormal and orthogonal to the locked ones
+    auto orth = orthogonality<T2>(this->m, nevex, C, this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, C, A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
+
+TYPED_TEST(QRfixture, cholQR2Locked)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+    std::size_t locked = 20;
+    T2* C = this->Matrices->C().host();
+
+    // orthonormal locked columns, badly conditioned active columns
+    read_vectors(C, GetFileName<T2>() + "cond_10.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    this->Matrices->C().syncFromPtr();
+    ASSERT_EQ(this->DLA->cholQR2(0), 0);
+    this->Matrices->C().sync2Ptr();
+    std::vector<T2> V(C, C + this->m * nevex);
+    read_vectors(V.data(), GetFileName<T2>() + "cond_1e4.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::copy(V.begin() + this->m * locked, V.end(), C + this->m * locked);
+    std::vector<T2> A(C, C + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    int info = this->DLA->cholQR2(locked);
+    ASSERT_EQ(info, 0);
+    this->Matrices->C().sync2Ptr();
+
+    // the active columns are orthonormal and orthogonal to the locked ones
+    auto orth = orthogonality<T2>(this->m, nevex, C, this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, C, A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
+
 TYPED_TEST(QRfixture, scholQR)
 {
     using T2 = typename TestFixture::T2;
@@ -94,3 +155,88 @@ TYPED_TEST(QRfixture, scholQR)
     auto orth = orthogonality<T2>(this->m, this->nev + this->nex, this->Matrices->C().host(), this->column_comm);
     ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 10);
 }
+
+TYPED_TEST(QRfixture, tsQR)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+
+    read_vectors(this->Matrices->C().host(), GetFileName<T2>() + "cond_1e4.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::vector<T2> A(this->Matrices->C().host(), this->Matrices->C().host() + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    this->DLA->tsQR(0);
+    this->Matrices->C().sync2Ptr();
+
+    auto orth = orthogonality<T2>(this->m, nevex, this->Matrices->C().host(), this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, this->Matrices->C().host(), A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
+
+TYPED_TEST(QRfixture, tsQRIllCond)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+
+    read_vectors(this->Matrices->C().host(), GetFileName<T2>() + "cond_ill.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::vector<T2> A(this->Matrices->C().host(), this->Matrices->C().host() + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    this->DLA->tsQR(0);
+    this->Matrices->C().sync2Ptr();
+
+    auto orth = orthogonality<T2>(this->m, nevex, this->Matrices->C().host(), this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, this->Matrices->C().host(), A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
+
+TYPED_TEST(QRfixture, tsQRLocked)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+    std::size_t locked = 20;
+    T2* C = this->Matrices->C().host();
+
+    // orthonormal locked columns, ill-conditioned active columns
+    read_vectors(C, GetFileName<T2>() + "cond_10.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    this->Matrices->C().syncFromPtr();
+    this->DLA->tsQR(0);
+    this->Matrices->C().sync2Ptr();
+    std::vector<T2> V(C, C + this->m * nevex);
+    read_vectors(V.data(), GetFileName<T2>() + "cond_ill.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::copy(V.begin() + this->m * locked, V.end(), C + this->m * locked);
+    std::vector<T2> A(C, C + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    this->DLA->tsQR(locked);
+    this->Matrices->C().sync2Ptr();
+
+    auto orth = orthogonality<T2>(this->m, nevex, C, this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, C, A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
+
+TYPED_TEST(QRfixtureTallSkinny, tsQR)
+{
+    using T2 = typename TestFixture::T2;
+    auto machineEpsilon = MachineEpsilon<T2>::value();
+    std::size_t nevex = this->nev + this->nex;
+
+    read_vectors(this->Matrices->C().host(), GetFileName<T2>() + "cond_ill.bin", this->xoff, this->xlen, this->N, nevex, this->column_rank);
+    std::vector<T2> A(this->Matrices->C().host(), this->Matrices->C().host() + this->m * nevex);
+    this->Matrices->C().syncFromPtr();
+
+    this->DLA->tsQR(0);
+    this->Matrices->C().sync2Ptr();
+
+    auto orth = orthogonality<T2>(this->m, nevex, this->Matrices->C().host(), this->column_comm);
+    ASSERT_NEAR(orth, machineEpsilon, machineEpsilon * 15);
+    auto res = residual<T2>(this->m, nevex, this->Matrices->C().host(), A.data(), this->column_comm);
+    EXPECT_LT(res, machineEpsilon * 50);
+}
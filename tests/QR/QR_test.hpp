@@ -81,6 +81,41 @@ chase::Base<T> orthogonality(std::size_t m, std::size_t nevex, T* C, MPI_Comm co
     return (nrmf / std::sqrt(nevex));
 }
 
+// ||A - Q R||_F / ||A||_F with R = Q^H A, restricted to its upper triangle
+// for a QR factorization of A
+template <typename T>
+chase::Base<T> residual(std::size_t m, std::size_t nevex, T* Q, T* A,
+                        MPI_Comm comm, bool upper = true)
+{
+    T one = T(1.0);
+    T negone = T(-1.0);
+    T zero = T(0.0);
+
+    std::vector<T> R(nevex * nevex);
+    t_gemm<T>(1, CblasConjTrans, CblasNoTrans, nevex, nevex, m, &one, Q, m,
+              A, m, &zero, R.data(), nevex);
+    MPI_Allreduce(MPI_IN_PLACE, R.data(), nevex * nevex, getMPI_Type<T>(),
+                  MPI_SUM, comm);
+    if (upper)
+    {
+        for (std::size_t j = 0; j < nevex; j++)
+            for (std::size_t i = j + 1; i < nevex; i++)
+                R[i + nevex * j] = zero;
+    }
+
+    std::vector<T> E(A, A + m * nevex);
+    t_gemm<T>(1, CblasNoTrans, CblasNoTrans, m, nevex, nevex, &negone, Q, m,
+              R.data(), nevex, &one, E.data(), m);
+
+    chase::Base<T> nrm[2] = {t_nrm2(m * nevex, E.data(), 1),
+                             t_nrm2(m * nevex, A, 1)};
+    nrm[0] *= nrm[0];
+    nrm[1] *= nrm[1];
+    MPI_Allreduce(MPI_IN_PLACE, nrm, 2, getMPI_Type<chase::Base<T>>(),
+                  MPI_SUM, comm);
+    return std::sqrt(nrm[0] / nrm[1]);
+}
+
 template <class T>
 class QRfixture : public testing::Test {
     protected:
@@ -155,3 +190,13 @@ class QRfixture : public testing::Test {
     MPI_Comm column_comm;
     int column_rank;
 };
+
+// fewer columns than the local rows of C
+template <class T>
+class QRfixtureTallSkinny : public QRfixture<T> {
+    protected:
+    QRfixtureTallSkinny() {
+        this->nev = 10;
+        this->nex = 5;
+    }
+};
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi_checkpoint.hpp"
+#include "algorithm/performance.hpp"
+
+#include "../spectrum.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class CheckpointFixture : public SpectrumFixture<T>
+{
+protected:
+    struct Run
+    {
+        std::vector<Base<T>> ritzv;
+        std::size_t iterations;
+        std::size_t vecs;
+    };
+
+    // solves a uniform spectrum of [-1, 1] with at most `maxiter`
+    // iterations, writing a checkpoint at each iteration or resuming from
+    // the last one
+    Run solve(std::size_t maxiter, bool checkpoint, bool resume)
+    {
+        SpectrumProblem<T> problem(this->lambda, nev, nex, MPI_COMM_WORLD);
+        auto single = problem.solver();
+        auto& config = single->GetConfig();
+        // low degrees, for a few iterations
+        config.SetDeg(6);
+        config.SetMaxDeg(12);
+        config.SetMaxIter(maxiter);
+        config.SetCheckpoint(file, checkpoint ? 1 : 0);
+        config.SetResume(resume);
+        if (interval)
+        {
+            config.SetInterval(-0.1, 0.1);
+        }
+
+        PerformanceDecoratorChase<T> performanceDecorator(single.get());
+        chase::Solve(&performanceDecorator);
+
+        auto& perf = performanceDecorator.GetPerfData();
+        return {std::vector<Base<T>>(problem.ritzv.begin(),
+                                     problem.ritzv.begin() + nev),
+                perf.get_iter_count(), perf.get_filtered_vecs()};
+    }
+
+    // a solve interrupted after 2 iterations and resumed is the same as an
+    // uninterrupted one
+    void resume()
+    {
+        auto fresh = solve(25, false, false);
+        auto first = solve(2, true, false);
+        auto second = solve(25, false, true);
+
+        ASSERT_GT(fresh.iterations, 3);
+        EXPECT_EQ(first.iterations, 2);
+        EXPECT_EQ(first.iterations + second.iterations, fresh.iterations);
+        EXPECT_EQ(first.vecs + second.vecs, fresh.vecs);
+        for (std::size_t i = 0; i < nev; i++)
+        {
+            EXPECT_NEAR(second.ritzv[i], fresh.ritzv[i], 1e-12);
+        }
+    }
+
+    void TearDown() override
+    {
+        MPI_Barrier(MPI_COMM_WORLD);
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if (rank == 0)
+        {
+            std::remove(file.c_str());
+        }
+    }
+
+    std::size_t nev = 30;
+    std::size_t nex = 15;
+    bool interval = false;
+    std::string file = "checkpoint_test.ckpt";
+};
+
+typedef ::testing::Types<double, std::complex<double>> MyTypes;
+TYPED_TEST_SUITE(CheckpointFixture, MyTypes);
+
+TYPED_TEST(CheckpointFixture, Resume)
+{
+    this->resume();
+}
+
+TYPED_TEST(CheckpointFixture, ResumeInterval)
+{
+    this->interval = true;
+    this->resume();
+}
+
+TYPED_TEST(CheckpointFixture, RejectOtherInterval)
+{
+    using T = TypeParam;
+    SpectrumProblem<T> problem(this->lambda, this->nev, this->nex,
+                               MPI_COMM_WORLD);
+    std::size_t nevex = this->nev + this->nex;
+    std::vector<T>& V = problem.V;
+    std::fill(V.begin(), V.end(), T(1));
+
+    ChaseState<T> state;
+    state.iteration = 3;
+    state.interval = true;
+    state.center = 0.25;
+    state.ritzv.assign(nevex, 0);
+    state.resid.assign(nevex, 0);
+    state.residLast.assign(nevex, 0);
+    state.degrees.assign(nevex, 10);
+
+    ChaseMpiCheckpoint<T> checkpoint(problem.props.get());
+    checkpoint.write(this->file, state, V.data());
+    checkpoint.wait();
+
+    ChaseState<T> other;
+    other.interval = false;
+    EXPECT_FALSE(checkpoint.read(this->file, other, V.data()));
+    other.interval = true;
+    other.center = 0.5;
+    EXPECT_FALSE(checkpoint.read(this->file, other, V.data()));
+    other.center = 0.25;
+    EXPECT_TRUE(checkpoint.read(this->file, other, V.data()));
+    EXPECT_EQ(other.iteration, 3);
+}
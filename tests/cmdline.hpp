@@ -0,0 +1,30 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+// Helpers for the `--key=value` options of the drivers in tests/.
+
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+//! Splits the comma-separated list `s`, dropping the empty items.
+inline std::vector<std::string> split(const std::string& s)
+{
+    std::vector<std::string> items;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
@@ -0,0 +1,120 @@
+#include <complex>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../spectrum.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class HierarchicalFixture : public SpectrumFixture<T>
+{
+protected:
+    void SetUp() override
+    {
+        setenv("CHASE_HIERARCHICAL_COLLECTIVES", "1", 1);
+        this->N = 120;
+        SpectrumFixture<T>::SetUp();
+    }
+
+    void TearDown() override { unsetenv("CHASE_HIERARCHICAL_COLLECTIVES"); }
+
+    // solves a uniform spectrum of [-1, 1] with the node-aware collectives
+    // on the grid `npr x npc`
+    void solve(int npr, int npc)
+    {
+        char grid_major = 'C';
+        std::size_t N = this->N;
+        auto props = new ChaseMpiProperties<T>(N, nev, nex, N / npr, N / npc,
+                                               npr, npc, &grid_major,
+                                               MPI_COMM_WORLD);
+        ASSERT_TRUE(props->get_mpi_wrapper().is_hierarchical());
+        std::vector<T> H(props->get_m() * props->get_n());
+        std::vector<T> V(props->get_m() * (nev + nex));
+        std::vector<Base<T>> ritzv(nev + nex);
+        props->generateHamiltonianSpectrum(this->lambda.data(), H.data());
+
+        ChaseMpi<ChaseMpiDLABlaslapack, T> single(props, H.data(),
+                                                  props->get_m(), V.data(),
+                                                  ritzv.data());
+        single.GetConfig().SetTol(1e-10);
+        chase::Solve(&single);
+
+        for (std::size_t i = 0; i < nev; i++)
+        {
+            EXPECT_NEAR(ritzv[i], this->lambda[i], 1e-9);
+        }
+    }
+
+    std::size_t nev = 12;
+    std::size_t nex = 8;
+};
+
+typedef ::testing::Types<double, std::complex<double>> MyTypes;
+TYPED_TEST_SUITE(HierarchicalFixture, MyTypes);
+
+TYPED_TEST(HierarchicalFixture, Solve)
+{
+    this->solve(2, 2);
+    this->solve(1, 4);
+    this->solve(4, 1);
+}
+
+TYPED_TEST(HierarchicalFixture, CreateDelete)
+{
+    using T = TypeParam;
+    // the properties own the node-aware collectives, while the backends
+    // hold copies of them and may outlive each other
+    for (int cycle = 0; cycle < 20; cycle++)
+    {
+        std::unique_ptr<ChaseMpiProperties<T>> first(new ChaseMpiProperties<T>(
+            this->N, this->nev, this->nex, MPI_COMM_WORLD));
+        std::unique_ptr<ChaseMpiProperties<T>> second(
+            new ChaseMpiProperties<T>(this->N, this->nev, this->nex,
+                                      MPI_COMM_WORLD));
+        Comm_t wrapper = first->get_mpi_wrapper();
+        T x = T(1);
+        AllReduce(HIER_BACKEND, &x, 1, getMPI_Type<T>(), MPI_SUM,
+                  first->get_col_comm(), wrapper);
+        int size;
+        MPI_Comm_size(first->get_col_comm(), &size);
+        EXPECT_EQ(x, T(size));
+        if (cycle % 2 == 0)
+        {
+            first.reset();
+            second.reset();
+        }
+        else
+        {
+            second.reset();
+            first.reset();
+        }
+        // the copy falls back to MPI once the collectives are released
+        EXPECT_FALSE(wrapper.is_hierarchical());
+    }
+}
+
+TEST(HierarchicalComm, EmptyFirstCall)
+{
+    HierarchicalComm hier(MPI_COMM_WORLD);
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    double x = 1;
+    hier.allreduce(MPI_IN_PLACE, &x, 0, MPI_DOUBLE, MPI_SUM);
+    hier.bcast(&x, 0, MPI_DOUBLE, 0);
+    EXPECT_EQ(x, 1);
+
+    std::vector<double> y(100, 1);
+    hier.allreduce(MPI_IN_PLACE, y.data(), 100, MPI_DOUBLE, MPI_SUM);
+    for (auto v : y)
+    {
+        EXPECT_EQ(v, size);
+    }
+    hier.free();
+    EXPECT_FALSE(hier.active());
+}
@@ -0,0 +1,367 @@
+/* -*- Mode: C++; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+// This file is a part of ChASE.
+// Copyright (c) 2015-2023, Simulation and Data Laboratory Quantum Materials,
+//   Forschungszentrum Juelich GmbH, Germany. All rights reserved.
+// License is 3-clause BSD:
+// https://github.com/ChASE-library/ChASE
+
+// Times each kernel of ChaseMpiDLA in isolation over a sweep of problem
+// sizes, grid shapes, data layouts and scalar types, and writes one JSON
+// record per kernel and configuration.
+//
+// Usage: mpirun -np <k> ./chase_kernels [--N=1000,2000] [--nevex=100,200]
+//            [--mb=0,64] [--grid=2x2,1x4] [--type=d,z] [--repeats=3]
+//            [--out=kernels.json]
+//
+// - `mb` lists the block sizes of the Block-Cyclic distribution, 0 stands
+//   for the Block-Block distribution.
+// - `grid` lists the shapes of the grid of ranks, by default all the
+//   factorizations of the number of ranks.
+// - `type` lists the scalar types among s, d, c and z.
+//
+// A timing is the maximum over the ranks and the minimum over the repeats.
+// `gflops` is derived from the operation count of the kernel on the
+// global problem, `gbs` from the bytes of communication counted by
+// ChaseCommStats on all the ranks.
+
+#include <complex>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ChASE-MPI/chase_mpi.hpp"
+#include "ChASE-MPI/chase_mpi_autotune.hpp"
+#include "algorithm/communication.hpp"
+
+#include "cmdline.hpp"
+
+#if defined(USE_GPU)
+#include "ChASE-MPI/impl/chase_mpidla_mgpu.hpp"
+#else
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
+#endif
+
+using namespace chase;
+using namespace chase::mpi;
+
+#if defined(USE_GPU)
+template <typename T>
+using Backend = ChaseMpiDLAMultiGPU<T>;
+#else
+template <typename T>
+using Backend = ChaseMpiDLABlaslapack<T>;
+#endif
+
+struct BenchConfig
+{
+    std::vector<std::size_t> N = {1000};
+    std::vector<std::size_t> nevex = {100};
+    std::vector<std::size_t> mb = {0};
+    std::vector<std::pair<int, int>> grids;
+    std::vector<std::string> types = {"d", "z"};
+    int repeats = 3;
+    std::string out;
+};
+
+std::vector<std::size_t> splitSizes(const std::string& s)
+{
+    std::vector<std::size_t> sizes;
+    for (auto& item : split(s))
+    {
+        sizes.push_back(std::stoul(item));
+    }
+    return sizes;
+}
+
+BenchConfig parse(int argc, char* argv[], int nprocs)
+{
+    BenchConfig conf;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        std::size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--N")
+            conf.N = splitSizes(value);
+        else if (key == "--nevex")
+            conf.nevex = splitSizes(value);
+        else if (key == "--mb")
+            conf.mb = splitSizes(value);
+        else if (key == "--type")
+            conf.types = split(value);
+        else if (key == "--repeats")
+            conf.repeats = std::max(1, std::stoi(value));
+        else if (key == "--out")
+            conf.out = value;
+        else if (key == "--grid")
+        {
+            for (auto& g : split(value))
+            {
+                std::size_t x = g.find('x');
+                conf.grids.emplace_back(std::stoi(g.substr(0, x)),
+                                        std::stoi(g.substr(x + 1)));
+            }
+        }
+        else
+            throw std::invalid_argument("unknown option " + arg);
+    }
+    if (conf.grids.empty())
+    {
+        for (int d0 = 1; d0 <= nprocs; d0++)
+        {
+            if (nprocs % d0 == 0)
+            {
+                conf.grids.emplace_back(d0, nprocs / d0);
+            }
+        }
+    }
+    return conf;
+}
+
+//! Total bytes counted by ChaseCommStats on this rank.
+std::size_t commBytes()
+{
+    std::size_t bytes = 0;
+    for (auto& c : ChaseCommStats::get().get_counters())
+    {
+        bytes += c.bytes;
+    }
+    return bytes;
+}
+
+template <typename T>
+class KernelBench
+{
+public:
+    KernelBench(const BenchConfig& conf, const std::string& type,
+                std::ostream& os, bool& first)
+        : conf_(conf), type_(type), os_(os), first_(first)
+    {
+    }
+
+    void run(std::size_t N, std::size_t nevex, std::size_t mb, int d0,
+             int d1)
+    {
+        N_ = N;
+        nevex_ = nevex;
+        mb_ = mb;
+        d0_ = d0;
+        d1_ = d1;
+        std::size_t nex = std::max<std::size_t>(1, nevex / 4);
+        std::size_t nev = nevex - nex;
+
+        std::unique_ptr<ChaseMpiProperties<T>> props;
+        if (mb == 0)
+        {
+            props.reset(new ChaseMpiProperties<T>(
+                N, nev, nex, N / d0, N / d1, d0, d1, const_cast<char*>("C"),
+                MPI_COMM_WORLD));
+        }
+        else
+        {
+            props.reset(new ChaseMpiProperties<T>(
+                N, mb, mb, nev, nex, d0, d1, const_cast<char*>("C"), 0, 0,
+                MPI_COMM_WORLD));
+        }
+        std::size_t m = props->get_m();
+        std::size_t n = props->get_n();
+        std::size_t ldh = props->get_ldh();
+
+        std::vector<T> H(ldh * n);
+        generate_bench_hamiltonian(props.get(), H.data());
+        std::vector<T> V(m * nevex);
+        std::vector<Base<T>> ritzv(nevex), resid(nevex);
+
+        ChaseMpiDLA<T> dla(props.get(), new Backend<T>(props.get(), H.data(),
+                                                       ldh, V.data(),
+                                                       ritzv.data()));
+        dla.Start();
+        dla.initRndVecs();
+        dla.initVecs();
+
+        double f = sizeof(T) == sizeof(Base<T>) ? 1 : 4;
+        double Nd = N, b = nevex;
+        double chol = f * (2 * Nd * b * b + b * b * b / 3);
+
+        // the product with H and the one with H^H alternate
+        time("apply_bAc", f * 2 * Nd * Nd * b,
+             [&]() { dla.apply(T(1), T(0), 0, nevex, 0); },
+             [&]() { dla.apply(T(1), T(0), 0, nevex, 0); });
+        time("apply_cAb", f * 2 * Nd * Nd * b,
+             [&]() { dla.apply(T(1), T(0), 0, nevex, 0); }, nullptr,
+             [&]() { dla.apply(T(1), T(0), 0, nevex, 0); });
+        dla.initVecs();
+
+        time("asynCxHGatherC", f * 2 * Nd * Nd * b,
+             [&]() { dla.asynCxHGatherC(0, nevex, true); });
+
+        std::vector<T> Cbuf(m * nevex, T(1)), Bbuf(n * nevex, T(1));
+        std::vector<T> target(N * nevex);
+        time("B2C", 0, [&]() { dla.B2C(Bbuf.data(), 0, Cbuf.data(), 0,
+                                       nevex); });
+        time("C2B", 0, [&]() { dla.C2B(Cbuf.data(), 0, Bbuf.data(), 0,
+                                       nevex); });
+        time("collecRedundantVecs_col", 0, [&]() {
+            dla.collecRedundantVecs(Cbuf.data(), target.data(), 0, nevex);
+        });
+        time("collecRedundantVecs_row", 0, [&]() {
+            dla.collecRedundantVecs(Bbuf.data(), target.data(), 1, nevex);
+        });
+
+        time("cholQR1", chol, [&]() { dla.cholQR1(0); });
+        time("cholQR2", 2 * chol, [&]() { dla.cholQR2(0); });
+        time("shiftedcholQR2", 3 * chol, [&]() { dla.shiftedcholQR2(0); });
+        time("hhQR", f * (4 * Nd * b * b - 4 * b * b * b / 3),
+             [&]() { dla.hhQR(0); });
+        time("tsQR", f * (4 * Nd * b * b - 4 * b * b * b / 3),
+             [&]() { dla.tsQR(0); });
+
+        time("RR",
+             f * (2 * Nd * Nd * b + 4 * Nd * b * b + 4 * b * b * b),
+             [&]() { dla.RR(nevex, 0, ritzv.data()); });
+        time("Resd", f * (2 * Nd * Nd * b + 4 * Nd * b), [&]() {
+            dla.Resd(ritzv.data(), resid.data(), 0, nevex);
+        });
+
+        const std::size_t M = 10;
+        int numvec = static_cast<int>(std::min<std::size_t>(4, nevex));
+        std::vector<Base<T>> d(M * numvec), e(M * numvec), beta(numvec);
+        dla.initVecs();
+        time("mLanczos", f * 2 * Nd * Nd * M * numvec, [&]() {
+            dla.mLanczos(M, numvec, d.data(), e.data(), beta.data());
+        });
+        dla.End();
+    }
+
+private:
+    //! Times `kernel`, run after the untimed `before` and followed by the
+    //! untimed `after`.
+    void time(const std::string& name, double flops,
+              std::function<void()> kernel,
+              std::function<void()> after = nullptr,
+              std::function<void()> before = nullptr)
+    {
+        std::size_t bytes = 0;
+        double best = time_kernel(
+            MPI_COMM_WORLD, conf_.repeats,
+            [&]() {
+                std::size_t bytes0 = commBytes();
+                kernel();
+                bytes = commBytes() - bytes0;
+            },
+            before, after);
+        unsigned long long total = bytes;
+        MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                      MPI_COMM_WORLD);
+
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if (rank != 0)
+        {
+            return;
+        }
+        os_ << (first_ ? "  " : ",\n  ") << "{\"kernel\":\"" << name
+            << "\",\"type\":\"" << type_ << "\",\"N\":" << N_
+            << ",\"nevex\":" << nevex_ << ",\"grid\":\"" << d0_ << "x" << d1_
+            << "\",\"layout\":\""
+            << (mb_ == 0 ? "Block-Block" : "Block-Cyclic")
+            << "\",\"mb\":" << mb_ << ",\"time\":" << best
+            << ",\"gflops\":" << flops / best / 1e9
+            << ",\"comm_bytes\":" << total << ",\"gbs\":" << total / best / 1e9
+            << "}";
+        first_ = false;
+    }
+
+    const BenchConfig& conf_;
+    std::string type_;
+    std::ostream& os_;
+    bool& first_;
+    std::size_t N_, nevex_, mb_;
+    int d0_, d1_;
+};
+
+template <typename T>
+void sweep(const BenchConfig& conf, const std::string& type,
+           std::ostream& os, bool& first)
+{
+    KernelBench<T> bench(conf, type, os, first);
+    for (auto N : conf.N)
+    {
+        for (auto nevex : conf.nevex)
+        {
+            for (auto& grid : conf.grids)
+            {
+                for (auto mb : conf.mb)
+                {
+                    // every rank must own at least one block and a column
+                    // of the vectors
+                    std::size_t d = std::max(grid.first, grid.second);
+                    if (nevex > N || (mb == 0 ? d : mb * d) > N)
+                    {
+                        continue;
+                    }
+                    bench.run(N, nevex, mb, grid.first, grid.second);
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank, nprocs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+    BenchConfig conf = parse(argc, argv, nprocs);
+    std::vector<std::pair<int, int>> grids;
+    for (auto& g : conf.grids)
+    {
+        if (g.first * g.second == nprocs)
+        {
+            grids.push_back(g);
+        }
+        else if (rank == 0)
+        {
+            std::cerr << "skipping grid " << g.first << "x" << g.second
+                      << " which does not match " << nprocs << " ranks\n";
+        }
+    }
+    conf.grids = grids;
+
+    std::ofstream file;
+    if (rank == 0 && !conf.out.empty())
+    {
+        file.open(conf.out);
+    }
+    std::ostream& os = file.is_open() ? file : std::cout;
+    if (rank == 0)
+    {
+        os << "[\n";
+    }
+    bool first = true;
+    for (auto& type : conf.types)
+    {
+        if (type == "s")
+            sweep<float>(conf, type, os, first);
+        else if (type == "d")
+            sweep<double>(conf, type, os, first);
+        else if (type == "c")
+            sweep<std::complex<float>>(conf, type, os, first);
+        else if (type == "z")
+            sweep<std::complex<double>>(conf, type, os, first);
+        else if (rank == 0)
+            std::cerr << "unknown scalar type " << type << "\n";
+    }
+    if (rank == 0)
+    {
+        os << "\n]\n";
+    }
+    MPI_Finalize();
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq_inplace.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_matrixfree_seq.hpp"
+
+#include "../spectrum.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class MatrixFreeFixture : public SpectrumFixture<T>
+{
+protected:
+    typedef ChaseMpi<ChaseMpiDLABlaslapackSeqInplace, T> CHASE;
+
+    // solves the problem and returns the nev sorted eigenvalues
+    std::vector<Base<T>> solve(CHASE& single)
+    {
+        auto& config = single.GetConfig();
+        config.SetTol(1e-10);
+        // H is Hermitian by construction, while the check of the dense
+        // backend compares H v and H^H v bitwise
+        config.EnableSymCheck(false);
+        chase::Solve(&single);
+
+        std::vector<Base<T>> ritzv(single.GetRitzv(),
+                                   single.GetRitzv() + nev);
+        std::sort(ritzv.begin(), ritzv.end());
+        return ritzv;
+    }
+
+    // the whole matrix, on a single rank
+    void SetUp() override
+    {
+        SpectrumFixture<T>::SetUp();
+        H = SpectrumProblem<T>(this->lambda, nev, nex, MPI_COMM_SELF).H;
+    }
+
+    std::size_t nev = 20;
+    std::size_t nex = 10;
+    std::vector<T> H;
+};
+
+typedef ::testing::Types<double, std::complex<double>> MyTypes;
+TYPED_TEST_SUITE(MatrixFreeFixture, MyTypes);
+
+TYPED_TEST(MatrixFreeFixture, SameAsDense)
+{
+    using T = TypeParam;
+    std::size_t N = this->N;
+    std::size_t nevex = this->nev + this->nex;
+
+    // the dense backend shifts its own copy of H
+    std::vector<T> Hd(this->H);
+    std::vector<T> Vd(N * nevex);
+    std::vector<Base<T>> ritzvd(nevex);
+    typename TestFixture::CHASE dense(N, this->nev, this->nex, Hd.data(), N,
+                                      Vd.data(), ritzvd.data());
+    auto expected = this->solve(dense);
+
+    const std::vector<T> H0(this->H);
+    std::size_t applied = 0;
+    T* H = this->H.data();
+    MatrixFreeApply<T> op = [&](std::size_t block, T alpha, Base<T> c, T* X,
+                                std::size_t ldx, T beta, T* Y,
+                                std::size_t ldy) {
+        // Y = alpha * (H - c I) X + beta * Y
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N, block, N,
+               &alpha, H, N, X, ldx, &beta, Y, ldy);
+        T shift = -alpha * T(c);
+        for (std::size_t j = 0; j < block; j++)
+        {
+            t_axpy(N, &shift, X + ldx * j, 1, Y + ldy * j, 1);
+        }
+        applied += block;
+    };
+    std::vector<T> V(N * nevex);
+    std::vector<Base<T>> ritzv(nevex);
+    typename TestFixture::CHASE matrixfree(
+        N, this->nev, this->nex,
+        new ChaseMpiDLAMatrixFreeSeq<T>(op, V.data(), ritzv.data(), N,
+                                        this->nev, this->nex));
+    auto found = this->solve(matrixfree);
+
+    // H is only accessed through the callback, and left untouched
+    EXPECT_GT(applied, 0);
+    EXPECT_TRUE(std::equal(this->H.begin(), this->H.end(), H0.begin()));
+    for (std::size_t i = 0; i < this->nev; i++)
+    {
+        EXPECT_NEAR(found[i], expected[i], 1e-9);
+        EXPECT_NEAR(found[i], this->lambda[i], 1e-9);
+    }
+}
+
+TYPED_TEST(MatrixFreeFixture, SymmetryCheck)
+{
+    using T = TypeParam;
+    std::size_t N = this->N;
+    std::vector<T> V(N * (this->nev + this->nex));
+    std::vector<Base<T>> ritzv(this->nev + this->nex);
+    std::vector<T> H(this->H);
+    MatrixFreeApply<T> op = [&](std::size_t block, T alpha, Base<T>, T* X,
+                                std::size_t ldx, T beta, T* Y,
+                                std::size_t ldy) {
+        t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, N, block, N,
+               &alpha, H.data(), N, X, ldx, &beta, Y, ldy);
+    };
+    ChaseMpiDLAMatrixFreeSeq<T> dla(op, V.data(), ritzv.data(), N,
+                                    this->nev, this->nex);
+    EXPECT_TRUE(dla.checkSymmetryEasy());
+
+    // a single element breaks the symmetry
+    H[N - 1] += T(1e-3);
+    EXPECT_FALSE(dla.checkSymmetryEasy());
+}
@@ -5,15 +5,41 @@
 // License is 3-clause BSD:
 // https://github.com/ChASE-library/ChASE
 
+// Solves a set of generated eigenproblems of known spectrum, checks the
+// computed eigenvalues against the exact ones and records the counters
+// and timings of each solve.
+//
+// Usage: ./chase_driver [--problems=clement,uniform,clustered,heavy,degenerate]
+//            [--N=1001] [--nev=80] [--nex=60] [--tol=1e-10] [--perturb=1e-4]
+//            [--baseline=FILE] [--compare=FILE] [--threshold=0.25]
+//
+// - `--perturb` adds to each matrix a random Hermitian perturbation of
+//   elements of this size, and solves it again from the previous solution
+//   (`SetApprox(true)`), recorded as the problem `<name>-approx`. 0 skips
+//   the second solve.
+// - `--baseline` writes the record of every problem to FILE.
+// - `--compare` reads the records of FILE and flags a regression when the
+//   number of iterations, the number of filtered vectors or the total time
+//   of a problem exceeds the one of FILE by more than `threshold`.
+//
+// The exit status is non-zero if an eigenvalue is off by more than the
+// bound given by the residual tolerance or if a regression is flagged.
+
+#include <algorithm>
 #include <complex>
+#include <fstream>
+#include <map>
 #include <memory>
-#include <random>
+#include <sstream>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 #include "ChASE-MPI/chase_mpi.hpp"
 #include "algorithm/performance.hpp"
 
+#include "cmdline.hpp"
+
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq.hpp"
 #include "ChASE-MPI/impl/chase_mpidla_blaslapack_seq_inplace.hpp"
 #if defined(USE_GPU)
@@ -32,101 +58,375 @@ typedef ChaseMpi<ChaseMpiDLACudaSeq, T> CHASE;
 typedef ChaseMpi<ChaseMpiDLABlaslapackSeqInplace, T> CHASE;
 #endif
 
-int main()
+//! Counters and timings of one solve, as written to the baseline file.
+struct Record
+{
+    std::size_t iterations = 0;
+    std::size_t vecs = 0;
+    std::vector<double> timings; // All, InitVecs, ..., Resids_Locking
+    double error = 0;            // max error of the eigenvalues
+};
+
+const std::vector<std::string> timing_names = {
+    "all", "initvecs", "lanczos", "filter", "qr", "rr", "resid"};
+
+//! Exact spectrum of the problem `name` of size `N`, in ascending order.
+std::vector<Base<T>> spectrum(const std::string& name, std::size_t N)
 {
-    MPI_Init(NULL, NULL);
+    std::vector<Base<T>> lambda(N);
+    for (std::size_t j = 0; j < N; j++)
+    {
+        if (name == "clement")
+        {
+            lambda[j] = -Base<T>(N - 1) + 2 * Base<T>(j);
+        }
+        else if (name == "uniform")
+        {
+            lambda[j] = -1 + 2 * Base<T>(j) / (N - 1);
+        }
+        else if (name == "clustered")
+        {
+            // clusters of 4 eigenvalues of width 3e-6
+            lambda[j] = Base<T>(j / 4) + 1e-6 * (j % 4);
+        }
+        else if (name == "heavy")
+        {
+            // a bulk in [0, 1) and a 2% tail growing geometrically up to
+            // 10, which stretches the interval damped by the filter
+            std::size_t tail = std::max<std::size_t>(1, N / 50);
+            std::size_t k = N - tail;
+            lambda[j] = j < k ? Base<T>(j) / N
+                              : std::pow(Base<T>(10), Base<T>(j - k + 1) /
+                                                          tail);
+        }
+        else if (name == "degenerate")
+        {
+            // pairs of eigenvalues separated by 1e-8
+            lambda[j] = Base<T>(j / 2) + 1e-8 * (j % 2);
+        }
+        else
+        {
+            throw std::invalid_argument("unknown problem " + name);
+        }
+    }
+    return lambda;
+}
+
+//! Generates the problem `name` in `H`: the Clement matrix is generated as
+//! a tridiagonal matrix, the other problems as `Q * diag(lambda) * Q^H`
+//! with `Q` the product of two Householder reflectors.
+void generate(const std::string& name, std::size_t N, std::size_t nev,
+              std::size_t nex, T* H)
+{
+    // all of `H` is local on a single rank
+    ChaseMpiProperties<T> props(N, nev, nex, MPI_COMM_SELF);
+    if (name == "clement")
+    {
+        // eigenvalues -(N-1), -(N-3), ..., N-1
+        props.generateHamiltonian(
+            [N](std::size_t i, std::size_t j) {
+                std::size_t k = std::max(i, j);
+                return i + 1 == k || j + 1 == k
+                           ? T(std::sqrt(Base<T>(k * (N - k))))
+                           : T(0);
+            },
+            H);
+        return;
+    }
+    auto lambda = spectrum(name, N);
+    props.generateHamiltonianSpectrum(lambda.data(), H);
+}
+
+//! Adds to `H` a random Hermitian matrix of normal elements scaled by
+//! `perturb`, and returns the Frobenius norm of the perturbation, which
+//! bounds the shift of each eigenvalue.
+Base<T> perturbation(std::size_t N, T* H, std::size_t ldh, Base<T> perturb)
+{
+    ChaseRandom rnd(7);
+    Base<T> norm = 0;
+    for (std::size_t j = 0; j < N; j++)
+    {
+        for (std::size_t i = 0; i <= j; i++)
+        {
+            T e = perturb * rnd.normal<T>(i, j);
+            if (i == j)
+            {
+                e = T(std::real(e));
+                H[i + ldh * j] += e;
+                norm += std::norm(e);
+            }
+            else
+            {
+                H[i + ldh * j] += e;
+                H[j + ldh * i] += conjugate(e);
+                norm += 2 * std::norm(e);
+            }
+        }
+    }
+    return std::sqrt(norm);
+}
+
+void writeRecords(const std::string& file,
+                  const std::vector<std::pair<std::string, Record>>& records)
+{
+    std::ofstream out(file);
+    out << "# problem iterations vecs";
+    for (auto& name : timing_names)
+    {
+        out << " " << name;
+    }
+    out << " error\n";
+    out << std::scientific << std::setprecision(6);
+    for (auto& r : records)
+    {
+        out << r.first << " " << r.second.iterations << " " << r.second.vecs;
+        for (auto t : r.second.timings)
+        {
+            out << " " << t;
+        }
+        out << " " << r.second.error << "\n";
+    }
+}
+
+std::map<std::string, Record> readRecords(const std::string& file)
+{
+    std::map<std::string, Record> records;
+    std::ifstream in(file);
+    if (!in)
+    {
+        throw std::runtime_error("cannot read the baseline " + file);
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::istringstream is(line);
+        std::string name;
+        Record r;
+        r.timings.resize(timing_names.size());
+        is >> name >> r.iterations >> r.vecs;
+        for (auto& t : r.timings)
+        {
+            is >> t;
+        }
+        is >> r.error;
+        records[name] = r;
+    }
+    return records;
+}
+
+//! Prints and returns whether `value` exceeds `base` by more than
+//! `threshold`.
+bool regressed(const std::string& problem, const std::string& what,
+               double value, double base, double threshold)
+{
+    if (value <= base * (1 + threshold))
+    {
+        return false;
+    }
+    std::cout << std::defaultfloat << "REGRESSION " << problem << ": " << what
+              << " " << value << " vs baseline " << base << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
     int rank = 0;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
 
     std::size_t N = 1001;
-    std::size_t LDH = 1001;
     std::size_t nev = 80;
     std::size_t nex = 60;
-    std::size_t idx_max = 2;
-    Base<T> perturb = 1e-4;
+    double tol = 1e-10;
+    double threshold = 0.25;
+    double perturb = 1e-4;
+    std::vector<std::string> problems = {"clement", "uniform", "clustered",
+                                         "heavy", "degenerate"};
+    std::string baseline, compare;
 
-    std::mt19937 gen(1337.0);
-    std::normal_distribution<> d;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg(argv[i]);
+        std::size_t eq = arg.find('=');
+        std::string key = arg.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+        if (key == "--problems")
+            problems = split(value);
+        else if (key == "--N")
+            N = std::stoul(value);
+        else if (key == "--nev")
+            nev = std::stoul(value);
+        else if (key == "--nex")
+            nex = std::stoul(value);
+        else if (key == "--tol")
+            tol = std::stod(value);
+        else if (key == "--baseline")
+            baseline = value;
+        else if (key == "--compare")
+            compare = value;
+        else if (key == "--threshold")
+            threshold = std::stod(value);
+        else if (key == "--perturb")
+            perturb = std::stod(value);
+        else
+        {
+            if (rank == 0)
+                std::cout << "unknown option " << arg << "\n";
+            MPI_Finalize();
+            return 1;
+        }
+    }
 
     if (rank == 0)
         std::cout << "ChASE example driver\n"
-                  << "Usage: ./driver \n";
+                  << "Usage: ./driver [--problems=clement,uniform,clustered,"
+                     "heavy,degenerate] [--N=1001] [--nev=80] [--nex=60] "
+                     "[--tol=1e-10] [--perturb=1e-4] [--baseline=FILE] "
+                     "[--compare=FILE] [--threshold=0.25]\n";
 
+    std::size_t LDH = N;
     auto V = std::vector<T>(N * (nev + nex));
     auto Lambda = std::vector<Base<T>>(nev + nex);
     std::vector<T> H(N * LDH, T(0.0));
 
-    CHASE single(N, nev, nex, H.data(), LDH, V.data(), Lambda.data());
+    std::vector<std::pair<std::string, Record>> records;
+    bool failed = false;
 
-    auto& config = single.GetConfig();
-    config.SetTol(1e-10);
-    config.SetDeg(20);
-    config.SetOpt(true);
-    config.SetApprox(false);
-    
-    if (rank == 0)
-        std::cout << "Solving " << idx_max << " symmetrized Clement matrices ("
-                  << N << "x" << N
-                  << ") with element-wise random perturbation of " << perturb
-                  << '\n'
-                  << config;
-
-    // Generate Clement matrix
-    for (auto i = 0; i < N; ++i)
-    {
-        H[i + N * i] = 0;
-        if (i != N - 1)
-            H[i + 1 + LDH * i] = std::sqrt(i * (N + 1 - i));
-        if (i != N - 1)
-            H[i + LDH * (i + 1)] = std::sqrt(i * (N + 1 - i));
-    }
-    
-    for (auto idx = 0; idx < idx_max; ++idx)
+    for (auto& problem : problems)
     {
-        if (rank == 0)
-        {
-            std::cout << "Starting Problem #" << idx << "\n";
-            if (config.UseApprox())
+        generate(problem, N, nev, nex, H.data());
+        auto exact = spectrum(problem, N);
+
+        CHASE single(N, nev, nex, H.data(), LDH, V.data(), Lambda.data());
+
+        auto& config = single.GetConfig();
+        config.SetTol(tol);
+        config.SetDeg(20);
+        config.SetOpt(true);
+        config.SetApprox(false);
+
+        auto solve = [&](const std::string& label, Base<T> shift) {
+            if (rank == 0)
+                std::cout << "Solving the " << label << " problem (" << N
+                          << "x" << N << ")\n"
+                          << config;
+
+            PerformanceDecoratorChase<T> performanceDecorator(&single);
+            chase::Solve(&performanceDecorator);
+
+            auto& perf = performanceDecorator.GetPerfData();
+            Record record;
+            record.iterations = perf.get_iter_count();
+            record.vecs = perf.get_filtered_vecs();
+            for (auto& t : perf.get_timings())
             {
-                std::cout << "Using approximate solution\n";
+                record.timings.push_back(t.count());
             }
-        }
 
-        PerformanceDecoratorChase<T> performanceDecorator(&single);
-        chase::Solve(&performanceDecorator);
+            // every Ritz value is within the norm of the residual matrix of
+            // an eigenvalue, and the sqrt(nev) factor bounds this norm by the
+            // residuals of the columns. The eigenvalues of a perturbed
+            // problem are within the norm of the perturbation of the exact
+            // ones.
+            std::vector<Base<T>> ritzv(Lambda.begin(), Lambda.begin() + nev);
+            std::sort(ritzv.begin(), ritzv.end());
+            Base<T> bound = std::max(
+                10 * tol * std::sqrt(Base<T>(nev)),
+                100 * std::numeric_limits<Base<T>>::epsilon() *
+                    std::max(std::abs(exact.front()),
+                             std::abs(exact.back()))) +
+                shift;
+            for (std::size_t i = 0; i < nev; i++)
+            {
+                record.error =
+                    std::max(record.error,
+                             double(std::abs(ritzv[i] - exact[i])));
+            }
+            bool accurate = record.error <= bound;
+            failed = failed || !accurate;
+
+            if (rank == 0)
+            {
+                perf.print();
+                Base<T>* resid = single.GetResid();
+                std::cout << "Finished the " << label << " problem, max error "
+                          << std::scientific << std::setprecision(3)
+                          << record.error << (accurate ? " <= " : " > ")
+                          << bound
+                          << (accurate ? "" : " FAILED") << "\n";
+                std::cout << "Printing first 5 eigenvalues and residuals\n";
+                std::cout
+                    << "| Index |       Eigenvalue      |         Exact       "
+                       "  |         Residual      |\n"
+                    << "|-------|-----------------------|---------------------"
+                       "--|-----------------------|\n";
+                std::size_t width = 20;
+                std::cout << std::setprecision(12);
+                std::cout << std::setfill(' ');
+                std::cout << std::scientific;
+                std::cout << std::right;
+                for (auto i = 0; i < std::min(std::size_t(5), nev); ++i)
+                    std::cout << "|  " << std::setw(4) << i + 1 << " | "
+                              << std::setw(width) << Lambda[i] << "  | "
+                              << std::setw(width) << exact[i] << "  | "
+                              << std::setw(width) << resid[i] << "  |\n";
+                std::cout << "\n\n\n";
+            }
+            records.emplace_back(label, record);
+        };
 
-        if (rank == 0)
+        solve(problem, 0);
+        if (perturb > 0)
         {
-            performanceDecorator.GetPerfData().print();
-            Base<T>* resid = single.GetResid();
-            std::cout << "Finished Problem #" << idx << "\n";
-            std::cout << "Printing first 5 eigenvalues and residuals\n";
-            std::cout
-                << "| Index |       Eigenvalue      |         Residual      |\n"
-                << "|-------|-----------------------|-----------------------|"
-                   "\n";
-            std::size_t width = 20;
-            std::cout << std::setprecision(12);
-            std::cout << std::setfill(' ');
-            std::cout << std::scientific;
-            std::cout << std::right;
-            for (auto i = 0; i < std::min(std::size_t(5), nev); ++i)
-                std::cout << "|  " << std::setw(4) << i + 1 << " | "
-                          << std::setw(width) << Lambda[i] << "  | "
-                          << std::setw(width) << resid[i] << "  |\n";
-            std::cout << "\n\n\n";
+            Base<T> shift = perturbation(N, H.data(), LDH, perturb);
+            config.SetApprox(true);
+            solve(problem + "-approx", shift);
         }
+    }
 
-        config.SetApprox(true);
-        // Perturb Full Clement matrix
-        for (std::size_t i = 1; i < N; ++i)
+    if (rank == 0)
+    {
+        if (!baseline.empty())
+        {
+            writeRecords(baseline, records);
+            std::cout << "Baseline written to " << baseline << "\n";
+        }
+        if (!compare.empty())
         {
-            for (std::size_t j = 1; j < i; ++j)
+            auto base = readRecords(compare);
+            for (auto& r : records)
             {
-                T element_perturbation = T(d(gen), d(gen)) * perturb;
-                H[j + LDH * i] += element_perturbation;
-                H[i + LDH * j] += std::conj(element_perturbation);
+                auto it = base.find(r.first);
+                if (it == base.end())
+                {
+                    std::cout << "No baseline for the " << r.first
+                              << " problem\n";
+                    continue;
+                }
+                bool iterations =
+                    regressed(r.first, "iterations", r.second.iterations,
+                              it->second.iterations, threshold);
+                bool vecs = regressed(r.first, "filtered vectors",
+                                      r.second.vecs, it->second.vecs,
+                                      threshold);
+                bool time = regressed(r.first, "time", r.second.timings[0],
+                                      it->second.timings[0], threshold);
+                failed = failed || iterations || vecs || time;
             }
+            std::cout << "Compared with " << compare << ": "
+                      << (failed ? "FAILED" : "passed") << "\n";
         }
     }
+
+    // written only if CHASE_TRACE is set
+    ChaseTracer::get().write(MPI_COMM_WORLD);
+
+    int status = failed ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Finalize();
+    return status;
 }
@@ -0,0 +1,116 @@
+#include <complex>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../spectrum.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class PermuteFixture : public SpectrumFixture<T>
+{
+protected:
+    PermuteFixture() { this->N = 60; }
+
+    // the column j of the vectors holds j + 1000 * (local row), the Ritz
+    // value j is j, and the vectors of the columns [locked, locked +
+    // index.size()) are permuted by `index`
+    void permute(std::size_t locked, const std::vector<std::size_t>& index)
+    {
+        SpectrumProblem<T> problem(this->lambda, nev, nex, MPI_COMM_WORLD);
+        auto single = problem.solver();
+        std::size_t m = problem.m;
+        std::size_t nevex = nev + nex;
+        std::vector<T>& V = problem.V;
+        for (std::size_t j = 0; j < nevex; j++)
+        {
+            for (std::size_t i = 0; i < m; i++)
+            {
+                V[i + m * j] = T(j + 1000 * i);
+            }
+        }
+        std::vector<Base<T>> values(nevex);
+        std::iota(values.begin(), values.end(), Base<T>(0));
+
+        permute_array(index, values.data() + locked);
+        permute_vectors(single.get(), locked, index);
+
+        // the expected column of each position
+        std::vector<std::size_t> expected(nevex);
+        std::iota(expected.begin(), expected.end(), 0);
+        for (std::size_t k = 0; k < index.size(); k++)
+        {
+            expected[locked + k] = locked + index[k];
+        }
+        for (std::size_t j = 0; j < nevex; j++)
+        {
+            EXPECT_EQ(values[j], Base<T>(expected[j]));
+            for (std::size_t i = 0; i < m; i++)
+            {
+                ASSERT_EQ(V[i + m * j], T(expected[j] + 1000 * i))
+                    << "row " << i << " column " << j;
+            }
+        }
+    }
+
+    std::size_t nev = 8;
+    std::size_t nex = 4;
+};
+
+typedef ::testing::Types<double, std::complex<double>> MyTypes;
+TYPED_TEST_SUITE(PermuteFixture, MyTypes);
+
+TYPED_TEST(PermuteFixture, Cycles)
+{
+    // the cycles (0 4 7 3 2 8 5 1) and (6) of the 9 active columns
+    this->permute(3, {4, 0, 8, 2, 7, 1, 6, 3, 5});
+}
+
+TYPED_TEST(PermuteFixture, LeadingActiveColumns)
+{
+    // the columns after the permuted range are left untouched
+    this->permute(2, {3, 2, 1, 0, 5, 4});
+}
+
+TYPED_TEST(PermuteFixture, NothingLocked)
+{
+    this->permute(0, {11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+}
+
+TYPED_TEST(PermuteFixture, Identity)
+{
+    this->permute(5, {0, 1, 2, 3, 4, 5, 6});
+}
+
+TYPED_TEST(PermuteFixture, Swap)
+{
+    using T = TypeParam;
+    SpectrumProblem<T> problem(this->lambda, this->nev, this->nex,
+                               MPI_COMM_WORLD);
+    auto single = problem.solver();
+    std::size_t m = problem.m;
+    std::size_t nevex = this->nev + this->nex;
+    std::vector<T>& V = problem.V;
+    for (std::size_t j = 0; j < nevex; j++)
+    {
+        for (std::size_t i = 0; i < m; i++)
+        {
+            V[i + m * j] = T(j + 1000 * i);
+        }
+    }
+
+    single->Swap(2, 7);
+
+    for (std::size_t j = 0; j < nevex; j++)
+    {
+        std::size_t expected = j == 2 ? 7 : j == 7 ? 2 : j;
+        for (std::size_t i = 0; i < m; i++)
+        {
+            ASSERT_EQ(V[i + m * j], T(expected + 1000 * i))
+                << "row " << i << " column " << j;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class RandomFixture : public testing::Test
+{
+protected:
+    // the initial vectors of the grid `npr x npc`, gathered on every rank:
+    // the block distribution if `mb == 0`, else the block-cyclic one with
+    // blocks of `mb x mb`
+    std::vector<T> initial_vectors(int npr, int npc, std::size_t mb)
+    {
+        char grid_major = 'C';
+        std::unique_ptr<ChaseMpiProperties<T>> props(
+            mb == 0 ? new ChaseMpiProperties<T>(N, nev, nex, N / npr, N / npc,
+                                                npr, npc, &grid_major,
+                                                MPI_COMM_WORLD)
+                    : new ChaseMpiProperties<T>(N, mb, mb, nev, nex, npr, npc,
+                                                &grid_major, 0, 0,
+                                                MPI_COMM_WORLD));
+        std::size_t m = props->get_m();
+        std::size_t nevex = nev + nex;
+        std::vector<T> H(m * props->get_n()), V(m * nevex);
+        std::vector<Base<T>> ritzv(nevex);
+        ChaseMpiDLABlaslapack<T> dla(props.get(), H.data(), m, V.data(),
+                                     ritzv.data());
+        dla.initRndVecs();
+
+        // the ranks of a column of the grid own disjoint rows
+        T* C = dla.getChaseMatrices()->C().host();
+        std::vector<T> W(N * nevex, T(0));
+        for (std::size_t b = 0; b < props->get_mblocks(); b++)
+        {
+            std::size_t off = props->get_row_offs()[b];
+            std::size_t off_l = props->get_row_offs_loc()[b];
+            for (std::size_t j = 0; j < nevex; j++)
+            {
+                for (std::size_t i = 0; i < props->get_row_lens()[b]; i++)
+                {
+                    W[off + i + N * j] = C[off_l + i + m * j];
+                }
+            }
+        }
+        MPI_Allreduce(MPI_IN_PLACE, W.data(), W.size(), getMPI_Type<T>(),
+                      MPI_SUM, props->get_col_comm());
+        return W;
+    }
+
+    // the initial vectors of every grid shape and distribution are the ones
+    // generated on a single process
+    void check(std::size_t mb)
+    {
+        std::vector<T> ref(N * (nev + nex));
+        ChaseRandom(1337).fill(N, nev + nex, ref.data(), N, 0);
+
+        for (auto grid : {std::make_pair(1, 4), std::make_pair(2, 2),
+                          std::make_pair(4, 1)})
+        {
+            auto W = initial_vectors(grid.first, grid.second, mb);
+            ASSERT_EQ(W, ref) << "grid " << grid.first << "x" << grid.second;
+        }
+    }
+
+    // divisible by the dimensions of the grids for the block distribution,
+    // such that the blocks of 7 end with a partial block
+    std::size_t N = 100;
+    std::size_t nev = 10;
+    std::size_t nex = 5;
+};
+
+typedef ::testing::Types<float, double, std::complex<float>,
+                         std::complex<double>>
+    MyTypes;
+TYPED_TEST_SUITE(RandomFixture, MyTypes);
+
+TYPED_TEST(RandomFixture, BlockDistribution) { this->check(0); }
+
+TYPED_TEST(RandomFixture, BlockCyclicDistribution) { this->check(7); }
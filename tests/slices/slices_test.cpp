@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi_slices.hpp"
+
+#include "../spectrum.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+template <typename T>
+class SlicesFixture : public SpectrumFixture<T>
+{
+protected:
+    // solves [lower, upper] of a uniform spectrum of [-1, 1] in two slices
+    // and returns the gathered eigenvalues
+    std::vector<Base<T>> solve(std::size_t nev, std::size_t nex)
+    {
+        ChaseMpiSlices<T> slices(MPI_COMM_WORLD, 2);
+        SpectrumProblem<T> problem(this->lambda, nev, nex,
+                                   slices.get_slice_comm());
+        auto single = problem.solver();
+        slices.partition(single.get(), lower, upper);
+        nev_advised = slices.get_nev();
+        chase::Solve(single.get());
+
+        auto found = slices.gather(single.get());
+        complete = slices.is_complete();
+        columns = slices.get_columns().size();
+        return found;
+    }
+
+    std::vector<Base<T>> exact() const
+    {
+        std::vector<Base<T>> inside;
+        std::copy_if(this->lambda.begin(), this->lambda.end(),
+                     std::back_inserter(inside),
+                     [&](Base<T> x) { return x >= lower && x <= upper; });
+        return inside;
+    }
+
+    Base<T> lower = -0.3;
+    Base<T> upper = 0.35;
+    std::size_t nev_advised = 0;
+    bool complete = false;
+    std::size_t columns = 0;
+};
+
+typedef ::testing::Types<double, std::complex<double>> MyTypes;
+TYPED_TEST_SUITE(SlicesFixture, MyTypes);
+
+TYPED_TEST(SlicesFixture, AllEigenvaluesOfTheInterval)
+{
+    auto exact = this->exact();
+    auto found = this->solve(50, 20);
+
+    EXPECT_LE(this->nev_advised, 50);
+    EXPECT_TRUE(this->complete);
+    ASSERT_EQ(found.size(), exact.size());
+    for (std::size_t i = 0; i < exact.size(); i++)
+    {
+        EXPECT_NEAR(found[i], exact[i], 1e-9);
+    }
+
+    // every eigenvalue is contributed by one group, with its vector
+    std::size_t columns = this->columns;
+    MPI_Allreduce(MPI_IN_PLACE, &columns, 1, MPI_UNSIGNED_LONG, MPI_SUM,
+                  MPI_COMM_WORLD);
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    EXPECT_EQ(columns, exact.size() * size / 2);
+}
+
+TYPED_TEST(SlicesFixture, IncompleteSlices)
+{
+    auto exact = this->exact();
+    auto found = this->solve(10, 10);
+
+    EXPECT_GT(this->nev_advised, 10);
+    EXPECT_FALSE(this->complete);
+    EXPECT_LT(found.size(), exact.size());
+    // the eigenvalues found are eigenvalues of the interval, once each
+    for (std::size_t i = 0; i < found.size(); i++)
+    {
+        auto it = std::lower_bound(exact.begin(), exact.end(), found[i] - 1e-9);
+        ASSERT_NE(it, exact.end());
+        EXPECT_NEAR(found[i], *it, 1e-9);
+        if (i > 0)
+        {
+            EXPECT_GT(found[i] - found[i - 1], 1e-3);
+        }
+    }
+}
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack_sparse.hpp"
+
+using namespace chase;
+using namespace chase::mpi;
+
+// max |A - B| / max |B| over the `n` entries
+template <typename T>
+Base<T> relative_error(std::size_t n, const T* A, const T* B)
+{
+    Base<T> err = 0, nrm = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        err = std::max(err, std::abs(A[i] - B[i]));
+        nrm = std::max(nrm, std::abs(B[i]));
+    }
+    return err / nrm;
+}
+
+template <typename T>
+class SparseFixture : public testing::Test
+{
+protected:
+    // a Hermitian band matrix, such that the BSR blocks far from the
+    // diagonal are not stored
+    T element(std::size_t i, std::size_t j) const
+    {
+        std::size_t lo = std::min(i, j), hi = std::max(i, j);
+        if (hi - lo > band)
+        {
+            return T(0);
+        }
+        T h = ChaseRandom(3).normal<T>(lo, hi);
+        if (i == j)
+        {
+            return T(std::real(h));
+        }
+        return i < j ? h : conjugate(h);
+    }
+
+    // B = alpha * (H + shift I)^H * C and then C = alpha * (H + shift I) * B
+    // with the random initial C, by ChaseMpiDLA over the local products of
+    // `backend`
+    void hemm(ChaseMpiDLAInterface<T>* backend, std::size_t locked,
+              std::vector<T>& B, std::vector<T>& C)
+    {
+        std::size_t nevex = nev + nex;
+        std::size_t block = nevex - locked;
+        ChaseMpiDLA<T> dla(props, backend);
+        dla.Start();
+        dla.initRndVecs();
+        dla.initVecs();
+        dla.shiftMatrix(T(shift));
+        dla.apply(alpha, T(0), 0, block, locked);
+        dla.apply(alpha, T(0), 0, block, locked);
+
+        auto* matrices = dla.getChaseMatrices();
+        matrices->B().sync2Ptr();
+        matrices->C().sync2Ptr();
+        T* b = matrices->B().host();
+        T* c = matrices->C().host();
+        B.assign(b + props->get_n() * locked, b + props->get_n() * nevex);
+        C.assign(c + props->get_m() * locked, c + props->get_m() * nevex);
+        dla.End();
+    }
+
+    // compares the products of the BSR backend of block size `bs` with the
+    // ones of the dense backend
+    void compare(std::size_t bs, std::size_t locked)
+    {
+        std::size_t m = props->get_m(), n = props->get_n();
+        std::size_t nevex = nev + nex;
+        std::vector<T> H(m * n), V(m * nevex);
+        std::vector<Base<T>> ritzv(nevex);
+        props->generateHamiltonian(
+            [this](std::size_t i, std::size_t j) { return element(i, j); },
+            H.data());
+
+        std::vector<T> B, C, Bs, Cs;
+        hemm(new ChaseMpiDLABlaslapack<T>(props, H.data(), m, V.data(),
+                                          ritzv.data()),
+             locked, B, C);
+        hemm(new ChaseMpiDLABlaslapackSparse<T>(
+                 props, BSRMatrix<T>::fromDense(m, n, bs, H.data(), m),
+                 V.data(), ritzv.data()),
+             locked, Bs, Cs);
+
+        auto eps = std::numeric_limits<Base<T>>::epsilon();
+        EXPECT_LT(relative_error(B.size(), Bs.data(), B.data()), 100 * eps);
+        EXPECT_LT(relative_error(C.size(), Cs.data(), C.data()), 100 * eps);
+    }
+
+    void SetUp() override
+    {
+        props = new ChaseMpiProperties<T>(N, nev, nex, MPI_COMM_WORLD);
+    }
+
+    void TearDown() override { delete props; }
+
+    // the local blocks of 52 or 51 rows and columns end with partial blocks
+    std::size_t N = 103;
+    std::size_t nev = 10;
+    std::size_t nex = 6;
+    std::size_t band = 9;
+    Base<T> shift = -0.5;
+    T alpha = T(0.5);
+    ChaseMpiProperties<T>* props;
+};
+
+typedef ::testing::Types<float, double, std::complex<float>,
+                         std::complex<double>>
+    MyTypes;
+TYPED_TEST_SUITE(SparseFixture, MyTypes);
+
+TYPED_TEST(SparseFixture, SpMMPartialBlocks)
+{
+    using T = TypeParam;
+    // 23 x 17 with blocks of 4: the last block row and column are partial
+    std::size_t m = 23, n = 17, k = 3, bs = 4;
+    std::vector<T> H(m * n), X(n * k), Y(m * k), XH(m * k), YH(n * k);
+    for (std::size_t j = 0; j < n; j++)
+    {
+        for (std::size_t i = 0; i < m; i++)
+        {
+            H[i + m * j] = this->element(i, j + 3);
+        }
+    }
+    ChaseRandom rnd(5);
+    rnd.fill(n, k, X.data(), n, 0);
+    rnd.fill(m, k, Y.data(), m, 0);
+    rnd.fill(m, k, XH.data(), m, 0, k);
+    rnd.fill(n, k, YH.data(), n, 0, k);
+
+    auto A = BSRMatrix<T>::fromDense(m, n, bs, H.data(), m);
+    auto AH = A.conjTranspose();
+    EXPECT_LT(A.nnzb(), A.mb() * A.nb());
+
+    T alpha = T(2), beta = T(-1);
+    std::vector<T> Yref(Y), YHref(YH);
+    t_gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, m, k, n, &alpha,
+           H.data(), m, X.data(), n, &beta, Yref.data(), m);
+    t_gemm(CblasColMajor, CblasConjTrans, CblasNoTrans, n, k, m, &alpha,
+           H.data(), m, XH.data(), m, &beta, YHref.data(), n);
+    A.spmm(k, alpha, X.data(), n, beta, Y.data(), m);
+    AH.spmm(k, alpha, XH.data(), m, beta, YH.data(), n);
+
+    auto eps = std::numeric_limits<Base<T>>::epsilon();
+    EXPECT_LT(relative_error(Y.size(), Y.data(), Yref.data()), 100 * eps);
+    EXPECT_LT(relative_error(YH.size(), YH.data(), YHref.data()), 100 * eps);
+}
+
+TYPED_TEST(SparseFixture, CSR) { this->compare(1, 0); }
+
+TYPED_TEST(SparseFixture, BSR) { this->compare(8, 0); }
+
+TYPED_TEST(SparseFixture, BSRLocked) { this->compare(8, 5); }
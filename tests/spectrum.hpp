@@ -0,0 +1,65 @@
+// The problem of known spectrum shared by the solver tests in tests/.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ChASE-MPI/chase_mpi.hpp"
+#include "ChASE-MPI/impl/chase_mpidla_blaslapack.hpp"
+
+//! A Hermitian matrix of spectrum `lambda`, distributed by a
+//! ChaseMpiProperties over `comm`, with the vectors and the Ritz values of
+//! a solve.
+template <typename T>
+struct SpectrumProblem
+{
+    SpectrumProblem(const std::vector<chase::Base<T>>& lambda,
+                    std::size_t nev, std::size_t nex, MPI_Comm comm)
+        : props(new chase::mpi::ChaseMpiProperties<T>(lambda.size(), nev,
+                                                      nex, comm)),
+          m(props->get_m()), H(m * props->get_n()), V(m * (nev + nex)),
+          ritzv(nev + nex)
+    {
+        props->generateHamiltonianSpectrum(lambda.data(), H.data());
+    }
+
+    //! The solver of the problem with the backend `MF` and a tolerance of
+    //! 1e-10, which takes the ownership of `props`.
+    template <template <typename> class MF =
+                  chase::mpi::ChaseMpiDLABlaslapack>
+    std::unique_ptr<chase::mpi::ChaseMpi<MF, T>> solver()
+    {
+        std::unique_ptr<chase::mpi::ChaseMpi<MF, T>> single(
+            new chase::mpi::ChaseMpi<MF, T>(props.release(), H.data(), m,
+                                            V.data(), ritzv.data()));
+        single->GetConfig().SetTol(1e-10);
+        return single;
+    }
+
+    std::unique_ptr<chase::mpi::ChaseMpiProperties<T>> props;
+    std::size_t m;
+    std::vector<T> H;
+    std::vector<T> V;
+    std::vector<chase::Base<T>> ritzv;
+};
+
+//! The uniform spectrum `lambda` of `[-1, 1]` of size `N`.
+template <typename T>
+class SpectrumFixture : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        lambda.resize(N);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            lambda[i] = -1 + chase::Base<T>(2 * i) / (N - 1);
+        }
+    }
+
+    std::size_t N = 200;
+    std::vector<chase::Base<T>> lambda;
+};